@@ -38,6 +38,9 @@
 #include "watchdog.h"
 #include "string.h"
 #include "onewire_info.h"
+#include "bootstage.h"
+#include "nand.h"
+#include "div.h"
 
 #include "arch/at91_pmc.h"
 #include "arch/at91_rstc.h"
@@ -230,6 +233,9 @@ void hw_init(void)
 	/* Init timer */
 	timer_init();
 
+	/* the earliest point that can be timed */
+	bootstage_mark("hw_init");
+
 #ifdef CONFIG_SCLK
 	slowclk_enable_osc32();
 #endif
@@ -239,14 +245,17 @@ void hw_init(void)
 
 #ifdef CONFIG_DDR2
 	/* Initialize MPDDR Controller */
+	bootstage_mark("ddramc_init");
 	ddramc_init();
 #endif
 	/* load one wire information */
+	bootstage_mark("one_wire_hw_init");
 	one_wire_hw_init();
 
 #ifdef CONFIG_USER_HW_INIT
 	hw_init_hook();
 #endif
+	bootstage_mark("hdmi_workaround");
 	HDMI_Qt1070_workaround();
 
 #if defined(CONFIG_NANDFLASH_RECOVERY) || defined(CONFIG_DATAFLASH_RECOVERY)
@@ -407,4 +416,58 @@ void nandflash_config_buswidth(unsigned char buswidth)
 
 	writel(mode, (ATMEL_BASE_SMC + SMC_MODE3));
 }
+
+#ifdef CONFIG_NANDFLASH_ONFI_TIMING
+/* MCK cycles, rounded up, for a time in ns */
+static unsigned int smc_cycles(unsigned int ns)
+{
+	unsigned int period_ps = div(1000000000, MASTER_CLOCK / 1000);
+
+	return div(ns * 1000 + period_ps - 1, period_ps);
+}
+
+static unsigned int smc_max(unsigned int a, unsigned int b)
+{
+	return (a > b) ? a : b;
+}
+
+/*
+ * Recompute the SMC CS3 read and write signals for the timings of the
+ * ONFI mode set in the chip. The data is sampled on the rising edge of
+ * NRD, so the NRD pulse also covers tREA. NCS stays asserted for the
+ * whole cycle. The TIMINGS and MODE registers are kept.
+ */
+void nandflash_config_timings(const struct nand_timings *timings)
+{
+	unsigned int nrd_pulse, nrd_cycle;
+	unsigned int nwe_pulse, nwe_cycle;
+
+	nrd_pulse = smc_cycles(smc_max(timings->tRP, timings->tREA));
+	nrd_cycle = smc_max(smc_cycles(timings->tRC),
+			1 + nrd_pulse + smc_cycles(timings->tREH));
+
+	nwe_pulse = smc_cycles(timings->tWP);
+	nwe_cycle = smc_max(smc_cycles(timings->tWC),
+			1 + nwe_pulse + smc_cycles(timings->tWH));
+
+	writel(AT91C_SMC_SETUP_NWE(1)
+		| AT91C_SMC_SETUP_NCS_WR(0)
+		| AT91C_SMC_SETUP_NRD(1)
+		| AT91C_SMC_SETUP_NCS_RD(0),
+		(ATMEL_BASE_SMC + SMC_SETUP3));
+
+	writel(AT91C_SMC_PULSE_NWE(nwe_pulse)
+		| AT91C_SMC_PULSE_NCS_WR(nwe_cycle)
+		| AT91C_SMC_PULSE_NRD(nrd_pulse)
+		| AT91C_SMC_PULSE_NCS_RD(nrd_cycle),
+		(ATMEL_BASE_SMC + SMC_PULSE3));
+
+	writel(AT91C_SMC_CYCLE_NWE(nwe_cycle)
+		| AT91C_SMC_CYCLE_NRD(nrd_cycle),
+		(ATMEL_BASE_SMC + SMC_CYCLE3));
+
+	dbg_log(DEBUG_LOUD, "NAND: SMC read cycle: %d, write cycle: %d\n\r",
+						nrd_cycle, nwe_cycle);
+}
+#endif
 #endif /* #ifdef CONFIG_NANDFLASH */
@@ -130,18 +130,37 @@
 
 #undef CONFIG_SYS_NAND_ENABLE_PIN
 
+#define CONFIG_SYS_NAND_NFC_CS		3	/* NFC chip select id */
+
+/* Fastest ONFI timing mode the SMC can be set up for */
+#define CONFIG_SYS_NAND_MAX_TIMING_MODE	5
+
+/*
+ * DMA Controller Settings
+ */
+#define CONFIG_SYS_DMAC_BASE		AT91C_BASE_DMAC0
+#define CONFIG_SYS_DMAC_ID		AT91C_ID_DMAC0
+
 #define CONFIG_LOOKUP_TABLE_ALPHA_OFFSET	0x14000
 #define CONFIG_LOOKUP_TABLE_INDEX_OFFSET	0x10000
 
 #define CONFIG_LOOKUP_TABLE_ALPHA_OFFSET_1024	0x20000
 #define CONFIG_LOOKUP_TABLE_INDEX_OFFSET_1024	0x18000
 
+/* SRAM1 is above CONFIG_TOP_OF_MEMORY, free for the generated tables */
+#define CONFIG_SYS_PMECC_TABLES_ADDR	AT91C_BASE_SRAM1
+
 
 /*
  * MCI Settings
  */
 #define CONFIG_SYS_BASE_MCI	AT91C_BASE_HSMCI0	
 
+/* DMAC0 handshaking interface of HSMCI0, and AHB interfaces used */
+#define CONFIG_SYS_MCI_DMA_PER		0
+#define CONFIG_SYS_MCI_DMA_PER_IF	0
+#define CONFIG_SYS_MCI_DMA_MEM_IF	2
+
 /*
  * Recovery function
  */
@@ -153,12 +172,24 @@
  */
 #define CONFIG_SYS_ONE_WIRE_PIN		AT91C_PIN_PE(25)
 
+/*
+ * MMU Settings
+ * The 16KB translation table sits at the end of the 512MB DDR,
+ * out of the way of the images being loaded.
+ */
+#define CONFIG_SYS_DDR_SIZE		0x20000000
+#define CONFIG_SYS_MMU_TTB		(AT91C_BASE_DDRCS \
+					+ CONFIG_SYS_DDR_SIZE - 0x4000)
+
 /* function */
 extern void hw_init(void);
 
 extern void nandflash_hw_init(void);
 extern void nandflash_config_buswidth(unsigned char busw);
 
+struct nand_timings;
+extern void nandflash_config_timings(const struct nand_timings *timings);
+
 extern void at91_spi0_hw_init(void);
 
 extern void at91_mci0_hw_init(void);
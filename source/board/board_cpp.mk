@@ -19,6 +19,11 @@ CPPFLAGS += -DCONFIG_THUMB -mthumb -mthumb-interwork
 ASFLAGS += -DCONFIG_THUMB -mthumb-interwork
 endif
 
+ifeq ($(CONFIG_MMU),y)
+CPPFLAGS += -DCONFIG_MMU
+ASFLAGS += -DCONFIG_MMU
+endif
+
 ifeq ($(CONFIG_SCLK),y)
 CPPFLAGS += -DCONFIG_SCLK
 endif
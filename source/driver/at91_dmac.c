@@ -0,0 +1,131 @@
+/* ----------------------------------------------------------------------------
+ *         ATMEL Microcontroller Software Support
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2013, Atmel Corporation
+
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the disclaimer below.
+ *
+ * Atmel's name may not be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * DISCLAIMER: THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "common.h"
+#include "hardware.h"
+#include "board.h"
+#include "arch/at91_pmc.h"
+#include "arch/at91_dmac.h"
+#include "dmac.h"
+#include "mmu.h"
+#include "debug.h"
+
+#define DMAC_TIMEOUT	0x1000000
+
+static inline unsigned int dmac_readl(unsigned int reg)
+{
+	return readl(CONFIG_SYS_DMAC_BASE + reg);
+}
+
+static inline void dmac_writel(unsigned int value, unsigned int reg)
+{
+	writel(value, CONFIG_SYS_DMAC_BASE + reg);
+}
+
+static inline void dmac_ch_writel(unsigned int channel,
+				unsigned int value,
+				unsigned int reg)
+{
+	writel(value, CONFIG_SYS_DMAC_BASE + DMAC_CH_OFFSET(channel) + reg);
+}
+
+void dmac_init(void)
+{
+#if (CONFIG_SYS_DMAC_ID < 32)
+	writel(1 << CONFIG_SYS_DMAC_ID, PMC_PCER + AT91C_BASE_PMC);
+#else
+	writel(1 << (CONFIG_SYS_DMAC_ID - 32), PMC_PCER1 + AT91C_BASE_PMC);
+#endif
+
+	dmac_writel(AT91C_DMAC_ENABLE, DMAC_EN);
+}
+
+/*
+ * Start a chain of linked list items on a channel: the DMAC loads the
+ * addresses and the controls from the first item, then goes on with
+ * the next ones until dscr is 0.
+ */
+void dmac_start(unsigned int channel,
+		struct dmac_desc *desc,
+		unsigned int cfg)
+{
+#ifdef CONFIG_MMU
+	struct dmac_desc *item;
+
+	/* The DMAC reads the items from memory */
+	for (item = desc; item; item = (struct dmac_desc *)item->dscr)
+		dcache_clean_range((unsigned int)item,
+				(unsigned int)item + sizeof(*item));
+#endif
+
+	/* Clear the pending status */
+	dmac_readl(DMAC_EBCISR);
+
+	dmac_ch_writel(channel, 0, DMAC_SADDR);
+	dmac_ch_writel(channel, 0, DMAC_DADDR);
+	dmac_ch_writel(channel, 0, DMAC_CTRLA);
+	dmac_ch_writel(channel, 0, DMAC_CTRLB);
+	dmac_ch_writel(channel, cfg, DMAC_CFG);
+	dmac_ch_writel(channel, (unsigned int)desc, DMAC_DSCR);
+
+	dmac_writel(AT91C_DMAC_ENA(channel), DMAC_CHER);
+}
+
+int dmac_busy(unsigned int channel)
+{
+	return (dmac_readl(DMAC_CHSR) & AT91C_DMAC_ENA(channel)) ? 1 : 0;
+}
+
+/* Wait for the end of the chain, the channel is then disabled */
+int dmac_wait(unsigned int channel)
+{
+	unsigned int timeout = DMAC_TIMEOUT;
+
+	while (dmac_busy(channel) && --timeout)
+		;
+
+	if (!timeout) {
+		dbg_log(1, "DMAC: Channel %d timeout\n\r", channel);
+		dmac_stop(channel);
+		return -1;
+	}
+
+	if (dmac_readl(DMAC_EBCISR) & AT91C_DMAC_ERR(channel)) {
+		dbg_log(1, "DMAC: Channel %d access error\n\r", channel);
+		return -1;
+	}
+
+	return 0;
+}
+
+void dmac_stop(unsigned int channel)
+{
+	dmac_writel(AT91C_DMAC_DIS(channel), DMAC_CHDR);
+
+	while (dmac_busy(channel))
+		;
+}
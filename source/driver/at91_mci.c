@@ -29,6 +29,10 @@
 #include "hardware.h"
 #include "board.h"
 #include "arch/at91_mci.h"
+#include "arch/at91_dmac.h"
+#include "mci_media.h"
+#include "dmac.h"
+#include "mmu.h"
 #include "div.h"
 #include "debug.h"
 
@@ -113,6 +117,10 @@ int at91_mci_init(unsigned int clock, unsigned int blklen)
 	/* enable mci */
 	mci_writel(MCI_CR, AT91C_MCI_MCIEN);
 
+#if defined(CONFIG_SDCARD_DMA) && !defined(CONFIG_SDCARD_PDC)
+	dmac_init();
+#endif
+
 	return 0;
 }
 
@@ -230,22 +238,61 @@ int at91_mci_read_block_data(unsigned int *data,
 	return 0;
 }
 
+/*
+ * Read the words of a block from the receive data register, through
+ * local pointers to the status and data registers. The error flags are
+ * cleared when the status register is read, so they are gathered over
+ * the block and checked once at its end; the wait for RXRDY only stops
+ * early on an error, not to hang on a data timeout.
+ */
+static int at91_mci_read_block_words(unsigned int *data, unsigned int words)
+{
+	volatile unsigned int *sr =
+		(volatile unsigned int *)(CONFIG_SYS_BASE_MCI + MCI_SR);
+	volatile unsigned int *rdr =
+		(volatile unsigned int *)(CONFIG_SYS_BASE_MCI + MCI_RDR);
+	unsigned int error_check = (AT91C_MCI_DCRCE
+					| AT91C_MCI_DTOE
+					| AT91C_MCI_OVRE);
+	unsigned int errors = 0;
+	unsigned int status;
+
+	while (words--) {
+		do {
+			status = *sr;
+			errors |= status;
+		} while (!(status & AT91C_MCI_RXRDY)
+				&& !(errors & error_check));
+
+		if (!(status & AT91C_MCI_RXRDY))
+			break;
+
+		*data++ = *rdr;
+	}
+
+	if (errors & error_check) {
+		dbg_log(1, "Error to read data, sr: %d\n\r", errors);
+		return -1;
+	}
+
+	return 0;
+}
+
 int at91_mci_read_blocks(unsigned int *data,
 			unsigned int blocks,
 			unsigned int block_len)
 {
 	unsigned int block;
-	unsigned int count;
 	unsigned int words_of_block = block_len >> 2;
 	int timeout = 10000;
 	int ret;
 
 	for (block = 0; block < blocks; block++) {
-		for (count = 0; count < words_of_block; count++, data++) {
-			ret = at91_mci_read_data(data);
-			if (ret)
-				return ret;
-		}
+		ret = at91_mci_read_block_words(data, words_of_block);
+		if (ret)
+			return ret;
+
+		data += words_of_block;
 	}
 
 	while ((mci_readl(MCI_SR) & AT91C_MCI_DTIP) && (--timeout))
@@ -311,3 +358,202 @@ int at91_mci_write_block_data(unsigned int *data,
 
 	return 0;
 }
+
+#ifdef CONFIG_SDCARD_DMA
+#ifdef CONFIG_SDCARD_PDC
+#define MCI_PDC_BUF_WORDS	0x8000	/* RCR and RNCR are 16-bit */
+#define MCI_PDC_TIMEOUT		0x1000000
+
+/*
+ * Set up the PDC of the MCI to move the blocks of the next read command
+ * to data, before the command is sent: the current buffer takes the first
+ * MCI_PDC_BUF_WORDS words, the next buffer the rest.
+ * Returns -1 if the buffer can't be used, the caller then reads the
+ * blocks with at91_mci_read_blocks().
+ */
+int at91_mci_dma_start(unsigned int *data,
+			unsigned int blocks,
+			unsigned int block_len)
+{
+	unsigned int words = blocks * (block_len >> 2);
+	unsigned int count;
+
+	if (((unsigned int)data & 0x03) || (words > 2 * MCI_PDC_BUF_WORDS))
+		return -1;
+
+	mci_writel(MCI_PTCR, AT91C_MCI_PDC_RXTDIS | AT91C_MCI_PDC_TXTDIS);
+
+	count = (words > MCI_PDC_BUF_WORDS) ? MCI_PDC_BUF_WORDS : words;
+	mci_writel(MCI_RPR, (unsigned int)data);
+	mci_writel(MCI_RCR, count);
+	mci_writel(MCI_RNPR, (unsigned int)(data + count));
+	mci_writel(MCI_RNCR, words - count);
+
+	mci_writel(MCI_MR, mci_readl(MCI_MR) | AT91C_MCI_PDCMODE);
+	mci_writel(MCI_PTCR, AT91C_MCI_PDC_RXTEN);
+
+	return 0;
+}
+
+void at91_mci_dma_stop(void)
+{
+	mci_writel(MCI_PTCR, AT91C_MCI_PDC_RXTDIS);
+	mci_writel(MCI_MR, mci_readl(MCI_MR) & ~AT91C_MCI_PDCMODE);
+}
+
+/* Wait for both PDC buffers to be full, then for the end of the transfer */
+int at91_mci_dma_wait(unsigned int *data,
+			unsigned int blocks,
+			unsigned int block_len)
+{
+	unsigned int status;
+	unsigned int errors = 0;
+	unsigned int error_check = (AT91C_MCI_DCRCE
+					| AT91C_MCI_DTOE
+					| AT91C_MCI_OVRE);
+	int timeout = MCI_PDC_TIMEOUT;
+
+	do {
+		status = mci_readl(MCI_SR);
+		errors |= status;
+	} while (!(status & AT91C_MCI_RXBUFF)
+			&& !(errors & error_check) && --timeout);
+
+	if (timeout && !(errors & error_check)) {
+		do {
+			status = mci_readl(MCI_SR);
+			errors |= status;
+		} while ((status & AT91C_MCI_DTIP) && --timeout);
+	}
+
+	at91_mci_dma_stop();
+
+	if (errors & error_check) {
+		dbg_log(1, "Error to read data, sr: %d\n\r", errors);
+		return -1;
+	}
+
+	if (!timeout) {
+		dbg_log(1, "Data Transfer in Progress.\n\r");
+		return -1;
+	}
+
+	return 0;
+}
+#else
+#define MCI_DMA_CHANNEL		1
+#define MCI_DMA_ALIGN		32	/* cache line */
+#define MCI_DMA_DESC_WORDS	0x4000	/* BTSIZE is 16-bit */
+#define MCI_DMA_DESCS		((MCI_DMA_MAX_BLOCKS * 512) \
+					/ (MCI_DMA_DESC_WORDS * 4))
+#define MCI_DMA_TIMEOUT		0x100000
+
+static struct dmac_desc mci_dma_desc[MCI_DMA_DESCS]
+			__attribute__((aligned(MCI_DMA_ALIGN)));
+
+static void mci_dma_invalidate(unsigned int *start, unsigned int len)
+{
+#ifdef CONFIG_MMU
+	dcache_invalidate_range((unsigned int)start, (unsigned int)start + len);
+#endif
+}
+
+/*
+ * Set up the DMAC to move the blocks of the next read command from the
+ * MCI receive data register to data, before the command is sent.
+ * Returns -1 if the buffer can't be used for DMA, the caller then reads
+ * the blocks with at91_mci_read_blocks().
+ */
+int at91_mci_dma_start(unsigned int *data,
+			unsigned int blocks,
+			unsigned int block_len)
+{
+	unsigned int words = blocks * (block_len >> 2);
+	unsigned int daddr = (unsigned int)data;
+	unsigned int count;
+	unsigned int i;
+
+	if ((daddr & (MCI_DMA_ALIGN - 1))
+		|| (words > (MCI_DMA_DESCS * MCI_DMA_DESC_WORDS)))
+		return -1;
+
+	for (i = 0; words; i++) {
+		count = (words > MCI_DMA_DESC_WORDS) ?
+				MCI_DMA_DESC_WORDS : words;
+
+		mci_dma_desc[i].saddr = CONFIG_SYS_BASE_MCI + MCI_RDR;
+		mci_dma_desc[i].daddr = daddr;
+		mci_dma_desc[i].ctrla = count
+				| AT91C_DMAC_SRC_WIDTH_WORD
+				| AT91C_DMAC_DST_WIDTH_WORD;
+		mci_dma_desc[i].ctrlb = AT91C_DMAC_SIF(CONFIG_SYS_MCI_DMA_PER_IF)
+				| AT91C_DMAC_DIF(CONFIG_SYS_MCI_DMA_MEM_IF)
+				| AT91C_DMAC_FC_PER2MEM
+				| AT91C_DMAC_SRC_INCR_FIXED
+				| AT91C_DMAC_DST_INCR_INCREMENTING;
+
+		words -= count;
+		daddr += count << 2;
+		mci_dma_desc[i].dscr = words ?
+				(unsigned int)&mci_dma_desc[i + 1] : 0;
+	}
+
+	mci_dma_invalidate(data, blocks * block_len);
+
+	mci_writel(MCI_DMA, AT91C_MCI_DMAEN_ENABLE | AT91C_MCI_CHKSIZE_1);
+
+	dmac_start(MCI_DMA_CHANNEL, mci_dma_desc,
+			AT91C_DMAC_SRC_PER(CONFIG_SYS_MCI_DMA_PER)
+			| AT91C_DMAC_SRC_H2SEL
+			| AT91C_DMAC_FIFOCFG_HALF);
+
+	return 0;
+}
+
+void at91_mci_dma_stop(void)
+{
+	dmac_stop(MCI_DMA_CHANNEL);
+	mci_writel(MCI_DMA, AT91C_MCI_DMAEN_DISABLE);
+}
+
+/* Wait for the DMAC, then for the end of the MCI transfer */
+int at91_mci_dma_wait(unsigned int *data,
+			unsigned int blocks,
+			unsigned int block_len)
+{
+	unsigned int status;
+	unsigned int error_check = (AT91C_MCI_DCRCE
+					| AT91C_MCI_DTOE
+					| AT91C_MCI_OVRE
+					| AT91C_MCI_BLKOVRE);
+	int timeout = MCI_DMA_TIMEOUT;
+	int ret;
+
+	ret = dmac_wait(MCI_DMA_CHANNEL);
+
+	do {
+		status = mci_readl(MCI_SR);
+	} while (!(status & (AT91C_MCI_XFRDONE | error_check)) && --timeout);
+
+	mci_writel(MCI_DMA, AT91C_MCI_DMAEN_DISABLE);
+
+	/* Lines may have been fetched speculatively during the transfer */
+	mci_dma_invalidate(data, blocks * block_len);
+
+	if (ret)
+		return ret;
+
+	if (status & error_check) {
+		dbg_log(1, "Error to read data, sr: %d\n\r", status);
+		return -1;
+	}
+
+	if (!timeout) {
+		dbg_log(1, "Data Transfer in Progress.\n\r");
+		return -1;
+	}
+
+	return 0;
+}
+#endif /* #ifdef CONFIG_SDCARD_PDC */
+#endif /* #ifdef CONFIG_SDCARD_DMA */
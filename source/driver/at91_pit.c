@@ -66,6 +66,26 @@ static unsigned int at91_get_pit_value(void)
 	return(pit_readl(PIT_PIIR));
 }
 
+/*
+ * PIIR holds PICNT above the 20-bit CPIV, and as the PIV is the maximum
+ * one, it counts MCK/16 ticks over the full 32 bits, wrapping every
+ * 520 s at 132 MHz. Extend it to a 64-bit monotonic count, which works
+ * as long as it is read at least once per wrap.
+ */
+static unsigned int pit_high;
+static unsigned int pit_last;
+
+unsigned long long timer_get_ticks(void)
+{
+	unsigned int current = at91_get_pit_value();
+
+	if (current < pit_last)
+		pit_high++;
+	pit_last = current;
+
+	return ((unsigned long long)pit_high << 32) | current;
+}
+
 /* Because the below statement is used in the function:
  *	((MASTER_CLOCK >> 10) * usec) is used,
  * to our 32-bit system. the argu "usec" maximum value is:
@@ -52,7 +52,8 @@ int slowclk_switch_osc32(void)
 
 	/*
 	 * Wait 32768 Hz Startup Time for clock stabilization (software loop)
-	 * wait about 1s (1000ms)
+	 * wait about 1s (1000ms), counted from the start_interval_timer() of
+	 * slowclk_enable_osc32(): only what is left of it is spent here
 	 */
 	wait_interval_timer(1000);
 
@@ -0,0 +1,149 @@
+/* ----------------------------------------------------------------------------
+ *         ATMEL Microcontroller Software Support
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2013, Atmel Corporation
+
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the disclaimer below.
+ *
+ * Atmel's name may not be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * DISCLAIMER: THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "common.h"
+#include "hardware.h"
+#include "board.h"
+#include "string.h"
+#include "timer.h"
+#include "div.h"
+#include "fdt.h"
+#include "bootstage.h"
+#include "dbgu.h"
+
+/* Must be a power of 2, the oldest records are overwritten */
+#define BOOTSTAGE_RECORDS	32
+
+/* Room for the /chosen "bootstage" property */
+#define BOOTSTAGE_DT_SIZE	1024
+
+struct bootstage_record {
+	const char		*name;
+	unsigned long long	ticks;
+};
+
+static struct bootstage_record records[BOOTSTAGE_RECORDS];
+static unsigned int record_count;
+
+void bootstage_mark(const char *name)
+{
+	struct bootstage_record *record;
+
+	record = &records[record_count & (BOOTSTAGE_RECORDS - 1)];
+	record->name = name;
+	record->ticks = timer_get_ticks();
+
+	record_count++;
+}
+
+static unsigned int bootstage_count(void)
+{
+	return (record_count < BOOTSTAGE_RECORDS) ?
+				record_count : BOOTSTAGE_RECORDS;
+}
+
+/* The index'th oldest record still in the ring */
+static struct bootstage_record *bootstage_get(unsigned int index)
+{
+	unsigned int first = record_count - bootstage_count();
+
+	return &records[(first + index) & (BOOTSTAGE_RECORDS - 1)];
+}
+
+/* The PIT runs at MCK/16 */
+static unsigned int ticks_to_usec(unsigned int ticks)
+{
+	unsigned int mhz = MASTER_CLOCK / 1000000;
+	unsigned int quotient = 0;
+	unsigned int remainder = 0;
+
+	division(ticks, mhz, &quotient, &remainder);
+
+	return (quotient << 4) + div(remainder << 4, mhz);
+}
+
+/* Start time of a record in us, relative to the oldest one */
+static unsigned int bootstage_usec(unsigned int index)
+{
+	unsigned long long base = bootstage_get(0)->ticks;
+
+	return ticks_to_usec((unsigned int)(bootstage_get(index)->ticks - base));
+}
+
+void bootstage_report(void)
+{
+	unsigned int count = bootstage_count();
+	unsigned int start, next;
+	unsigned int i;
+
+	/* Straight to the DBGU: dbg_log() is compiled out without CONFIG_DEBUG */
+	dbgu_print("\n\rBoot stages (us):\n\r");
+
+	for (i = 0; i < count; i++) {
+		start = bootstage_usec(i);
+
+		dbgu_print("  ");
+		dbgu_print(bootstage_get(i)->name);
+		dbgu_print(": start: ");
+		dbgu_print_dec(start);
+
+		if (i + 1 < count) {
+			next = bootstage_usec(i + 1);
+			dbgu_print(", took: ");
+			dbgu_print_dec(next - start);
+		}
+		dbgu_print("\n\r");
+	}
+}
+
+#ifdef CONFIG_OF_LIBFDT
+int bootstage_fixup_dt(void *blob)
+{
+	unsigned char buf[BOOTSTAGE_DT_SIZE];
+	unsigned int count = bootstage_count();
+	unsigned int namelen;
+	unsigned int len = 0;
+	unsigned int usec;
+	unsigned int i;
+
+	for (i = 0; i < count; i++) {
+		namelen = strlen(bootstage_get(i)->name) + 1;
+		if ((len + OF_ALIGN(namelen) + 4) > BOOTSTAGE_DT_SIZE)
+			break;
+
+		memset(buf + len, 0, OF_ALIGN(namelen));
+		memcpy(buf + len, bootstage_get(i)->name, namelen);
+		len += OF_ALIGN(namelen);
+
+		usec = swap_uint32(bootstage_usec(i));
+		memcpy(buf + len, &usec, 4);
+		len += 4;
+	}
+
+	return fixup_chosen_property(blob, "bootstage", buf, len);
+}
+#endif
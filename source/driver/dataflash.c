@@ -35,6 +35,7 @@
 #include "timer.h"
 #include "div.h"
 #include "debug.h"
+#include "bootstage.h"
 
 /* Manufacturer Device ID Read */
 #define CMD_READ_DEV_ID			0x9f
@@ -556,12 +557,34 @@ static int dataflash_probe_atmel(struct dataflash_descriptor *df_desc)
 	return 0;
 }
 
+#if defined(CONFIG_LOAD_LINUX) || defined(CONFIG_LOAD_ANDROID)
+/*
+ * Read the first page of the image and work out from its header how many
+ * bytes really have to be read, instead of the whole partition window.
+ */
+static int update_image_length(struct dataflash_descriptor *df_desc,
+				unsigned int offset,
+				unsigned int length,
+				unsigned char *dest,
+				unsigned char flag)
+{
+	int ret;
+
+	ret = dataflash_read_array(df_desc, offset, df_desc->page_size, dest);
+	if (ret)
+		return -1;
+
+	return image_header_length(dest, length, flag);
+}
+#endif
+
 int load_dataflash(struct image_info *image)
 {
 	struct dataflash_descriptor	df_descriptor;
 	struct dataflash_descriptor	*df_desc = &df_descriptor;
 	int ret = 0;
 
+	bootstage_mark("sf_init");
 	at91_spi0_hw_init();
 
 	ret = at91_spi_init(AT91C_SPI_PCS_DATAFLASH,
@@ -587,6 +610,20 @@ int load_dataflash(struct image_info *image)
 	}
 #endif
 
+	bootstage_mark("sf_load_image");
+
+#if defined(CONFIG_LOAD_LINUX) || defined(CONFIG_LOAD_ANDROID)
+	ret = update_image_length(df_desc, image->offset,
+				image->length, image->dest, KERNEL_IMAGE);
+	if (ret < 0) {
+		ret = -1;
+		goto err_exit;
+	}
+
+	image->length = ret;
+	image->dest = kernel_image_dest(image, image->length);
+#endif
+
 	dbg_log(1, "SF: Copy %d bytes from %d to %d\n\r",
 			image->length, image->offset, image->dest);
 
@@ -599,6 +636,18 @@ int load_dataflash(struct image_info *image)
 	}
 
 	if (image->of) {
+		bootstage_mark("sf_load_dtb");
+
+#if defined(CONFIG_LOAD_LINUX) || defined(CONFIG_LOAD_ANDROID)
+		ret = update_image_length(df_desc, image->of_offset,
+				image->of_length, image->of_dest, DT_BLOB);
+		if (ret < 0) {
+			ret = -1;
+			goto err_exit;
+		}
+
+		image->of_length = ret;
+#endif
 		dbg_log(1, "SF: dt blob: Copy %d bytes from %d to %d\n\r",
 			image->of_length, image->of_offset, image->of_dest);
 
@@ -27,6 +27,7 @@
  */
 #include "hardware.h"
 #include "arch/at91_dbgu.h"
+#include "div.h"
 
 static inline void write_dbgu(unsigned int offset, const unsigned int value)
 {
@@ -67,6 +68,23 @@ void dbgu_print(const char *ptr)
 	}
 }
 
+/* Print value in decimal, without the printf-like dbg_log() */
+void dbgu_print_dec(unsigned int value)
+{
+	char buf[11];
+	char *p = &buf[10];
+	unsigned int quotient, remainder;
+
+	*p = '\0';
+	do {
+		division(value, 10, &quotient, &remainder);
+		*--p = remainder + '0';
+		value = quotient;
+	} while (value);
+
+	dbgu_print(p);
+}
+
 char dbgu_getc(void)
 {
 	while (!(read_dbgu(DBGU_CSR) & AT91C_DBGU_RXRDY)) ;
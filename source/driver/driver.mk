@@ -5,6 +5,7 @@ DRIVERS:=
 DRIVERS_SRC:=$(TOPDIR)/driver
 
 COBJS-$(CONFIG_DEBUG)		+= $(DRIVERS_SRC)/debug.o
+COBJS-$(CONFIG_BOOTSTAGE)	+= $(DRIVERS_SRC)/bootstage.o
 
 COBJS-$(CONFIG_SCLK)		+= $(DRIVERS_SRC)/at91_slowclk.o
 
@@ -14,6 +15,9 @@ COBJS-y				+= $(DRIVERS_SRC)/at91_pit.o
 COBJS-y				+= $(DRIVERS_SRC)/at91_wdt.o
 COBJS-y				+= $(DRIVERS_SRC)/dbgu.o
 
+COBJS-$(CONFIG_MMU)		+= $(DRIVERS_SRC)/mmu.o
+COBJS-$(CONFIG_DMAC)		+= $(DRIVERS_SRC)/at91_dmac.o
+
 COBJS-$(CONFIG_USER_HW_INIT)	+= $(DRIVERS_SRC)/hw_init_hook.o
 
 COBJS-$(CONFIG_SDRAM)		+= $(DRIVERS_SRC)/sdramc.o
@@ -23,7 +27,11 @@ COBJS-$(CONFIG_DDR2)		+= $(DRIVERS_SRC)/ddramc.o
 COBJS-$(CONFIG_SDCARD)		+= $(DRIVERS_SRC)/at91_mci.o
 
 COBJS-$(CONFIG_SDCARD)		+= $(DRIVERS_SRC)/mci_media.o
+ifeq ($(CONFIG_SDCARD_RAW),y)
+COBJS-$(CONFIG_SDCARD)		+= $(DRIVERS_SRC)/sdcard_raw.o
+else
 COBJS-$(CONFIG_SDCARD)		+= $(DRIVERS_SRC)/sdcard.o
+endif
 
 ifeq ($(CONFIG_BOARD), "at91sam9260ek")
 COBJS-$(CONFIG_NANDFLASH)	+= $(DRIVERS_SRC)/nandflash_9260.o
@@ -31,6 +39,7 @@ else
 COBJS-$(CONFIG_NANDFLASH)	+= $(DRIVERS_SRC)/nandflash.o
 endif
 COBJS-$(CONFIG_ENABLE_SW_ECC) 	+= $(DRIVERS_SRC)/hamming.o
+COBJS-$(CONFIG_USE_PMECC)	+= $(DRIVERS_SRC)/pmecc.o
 
 COBJS-$(CONFIG_DATAFLASH)	+= $(DRIVERS_SRC)/at91_spi.o
 COBJS-$(CONFIG_DATAFLASH)	+= $(DRIVERS_SRC)/dataflash.o
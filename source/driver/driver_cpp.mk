@@ -62,6 +62,17 @@ ifeq ($(CONFIG_SDCARD),y)
 CPPFLAGS += -DCONFIG_SDCARD
 endif
 
+ifeq ($(CONFIG_SDCARD_RAW),y)
+CPPFLAGS += -DCONFIG_SDCARD_RAW
+CPPFLAGS += -DCONFIG_SDCARD_RAW_PART=$(CONFIG_SDCARD_RAW_PART)
+endif
+
+ifeq ($(CONFIG_SDCARD_INITRD),y)
+CPPFLAGS += -DCONFIG_SDCARD_INITRD
+CPPFLAGS += -DINITRD_FILENAME="\"$(INITRD_FILENAME)\""
+CPPFLAGS += -DINITRD_ADDRESS=$(INITRD_ADDRESS)
+endif
+
 ifeq ($(CONFIG_FLASH),y)
 CPPFLAGS += -DCONFIG_FLASH
 endif
@@ -78,6 +89,14 @@ ifeq ($(CONFIG_SDCARD_HS),y)
 CPPFLAGS += -DCONFIG_SDCARD_HS
 endif
 
+ifeq ($(CONFIG_SDCARD_DMA),y)
+CPPFLAGS += -DCONFIG_SDCARD_DMA
+endif
+
+ifeq ($(CONFIG_SDCARD_PDC),y)
+CPPFLAGS += -DCONFIG_SDCARD_PDC
+endif
+
 ifeq ($(CONFIG_OF_LIBFDT),y)
 CPPFLAGS += -DCONFIG_OF_LIBFDT
 endif
@@ -107,6 +126,26 @@ ifeq ($(CONFIG_NANDFLASH_SMALL_BLOCKS),y)
 CPPFLAGS += -DCONFIG_NANDFLASH_SMALL_BLOCKS
 endif
 
+ifeq ($(CONFIG_NANDFLASH_ONFI_TIMING),y)
+CPPFLAGS += -DCONFIG_NANDFLASH_ONFI_TIMING
+endif
+
+ifeq ($(CONFIG_NANDFLASH_STATS),y)
+CPPFLAGS += -DCONFIG_NANDFLASH_STATS
+endif
+
+ifeq ($(CONFIG_NANDFLASH_BBT),y)
+CPPFLAGS += -DCONFIG_NANDFLASH_BBT
+endif
+
+ifeq ($(CONFIG_NANDFLASH_DMA),y)
+CPPFLAGS += -DCONFIG_NANDFLASH_DMA
+endif
+
+ifeq ($(CONFIG_NANDFLASH_NFC),y)
+CPPFLAGS += -DCONFIG_NANDFLASH_NFC
+endif
+
 ifeq ($(CONFIG_ENABLE_SW_ECC), y)
 CPPFLAGS += -DCONFIG_ENABLE_SW_ECC
 endif
@@ -151,6 +190,10 @@ ifeq ($(CONFIG_PMECC_SECTOR_SIZE_1024), y)
 CPPFLAGS += -DPMECC_SECTOR_SIZE=1024
 endif
 
+ifeq ($(CONFIG_PMECC_SRAM_TABLES), y)
+CPPFLAGS += -DCONFIG_PMECC_SRAM_TABLES
+endif
+
 # Debug related stuff
 ifeq ($(CONFIG_DEBUG_INFO),y)
 CPPFLAGS += -DBOOTSTRAP_DEBUG_LEVEL=DEBUG_INFO
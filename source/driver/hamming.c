@@ -48,77 +48,96 @@ static unsigned char CountBitsInCode256(unsigned char *code)
 		+ CountBitsInByte(code[2]);
 }
 
+/* Parity of each byte value */
+#define P2(n)	n, n ^ 1, n ^ 1, n
+#define P4(n)	P2(n), P2(n ^ 1), P2(n ^ 1), P2(n)
+#define P6(n)	P4(n), P4(n ^ 1), P4(n ^ 1), P4(n)
+
+static const unsigned char ByteParity[256] = {
+	P6(0), P6(1), P6(1), P6(0)
+};
+
+static unsigned int WordParity(unsigned int word)
+{
+	word ^= word >> 16;
+	word ^= word >> 8;
+
+	return ByteParity[word & 0xff];
+}
+
+static unsigned int ReadWord(const unsigned char *data)
+{
+	if (((unsigned int)data & 0x03) == 0)
+		return *(const unsigned int *)data;
+
+	return data[0] | (data[1] << 8) | (data[2] << 16) | (data[3] << 24);
+}
+
 static void Compute256(const unsigned char *data, unsigned char *code)
 {
 	unsigned int i;
-	unsigned char columnSum = 0;
-	unsigned char evenLineCode = 0;
-	unsigned char oddLineCode = 0;
-	unsigned char evenColumnCode = 0;
-	unsigned char oddColumnCode = 0;
+	unsigned int word;
+	unsigned int sum = 0;
+	unsigned int lineSum[6] = {0, 0, 0, 0, 0, 0};
+	unsigned char columnSum;
+	unsigned int parity;
+	unsigned int odd, even;
 
 	/*
-	 * Xor all bytes together to get the column sum;
-	 * At the same time, calculate the even and odd line codes
+	 * Parity groups are formed by forcing a particular index bit to 0
+	 * (even) or 1 (odd).
+	 * Example on one byte:
+	 *
+	 * bits (dec)  7   6   5   4   3   2   1   0
+	 *      (bin) 111 110 101 100 011 010 001 000
+	 *                          '---'---'---'----------.
+	 *                                                  |
+	 * groups P4' ooooooooooooooo eeeeeeeeeeeeeee P4    |
+	 *        P2' ooooooo eeeeeee ooooooo eeeeeee P2    |
+	 *        P1' ooo eee ooo eee ooo eee ooo eee P1    |
+	 *                                                  |
+	 * We can see that:                                 |
+	 *  - P4  -> bit 2 of index is 0 -------------------'
+	 *  - P4' -> bit 2 of index is 1.
+	 *  - P2  -> bit 1 of index if 0.
+	 *  - etc...
+	 *
+	 * The same goes for the lines (bytes) of the 256-byte block: the odd
+	 * parity Px' is the parity of all the bytes whose index has the
+	 * log2(x)nth bit set, the even one Px is the parity of the others,
+	 * that is Px' xor the parity of the whole block.
+	 *
+	 * So xor the block by 32-bit words: the whole sum, and the sums of
+	 * the words whose index has the bit 0 .. 5 set (bit 2 .. 7 of the
+	 * byte index). The bit 0 and 1 of the byte index select the bytes
+	 * inside the words.
 	 */
-
-	for (i = 0; i < 256; i++) {
-		columnSum ^= data[i];
-
-		/*
-		 * If the xor sum of the byte is 0, then this byte has no incidence on
-		 * the computed code; so check if the sum is 1.
-		 */
-		if ((CountBitsInByte(data[i]) & 1) == 1) {
-
-			/*
-			 * Parity groups are formed by forcing a particular index bit to 0
-			 * (even) or 1 (odd).
-			 * Example on one byte:
-			 *
-			 * bits (dec)  7   6   5   4   3   2   1   0
-			 *      (bin) 111 110 101 100 011 010 001 000
-			 *                          '---'---'---'----------.
-			 *                                                  |
-			 * groups P4' ooooooooooooooo eeeeeeeeeeeeeee P4    |
-			 *        P2' ooooooo eeeeeee ooooooo eeeeeee P2    |
-			 *        P1' ooo eee ooo eee ooo eee ooo eee P1    |
-			 *                                                  |
-			 * We can see that:                                 |
-			 *  - P4  -> bit 2 of index is 0 -------------------'
-			 *  - P4' -> bit 2 of index is 1.
-			 *  - P2  -> bit 1 of index if 0.
-			 *  - etc...
-			 * We deduce that a bit position has an impact on all even Px if
-			 * the log2(x)nth bit of its index is 0
-			 *     ex: log2(4) = 2, bit2 of the index must be 0 (-> 0 1 2 3)
-			 * and on all odd Px' if the log2(x)nth bit of its index is 1
-			 *     ex: log2(2) = 1, bit1 of the index must be 1 (-> 0 1 4 5)
-			 *
-			 * As such, we calculate all the possible Px and Px' values at the
-			 * same time in two variables, evenLineCode and oddLineCode, such as
-			 *     evenLineCode bits: P128  P64  P32  P16  P8  P4  P2  P1
-			 *     oddLineCode  bits: P128' P64' P32' P16' P8' P4' P2' P1'
-			 */
-			evenLineCode ^= (255 - i);
-			oddLineCode ^= i;
-		}
+	for (i = 0; i < 64; i++) {
+		word = ReadWord(data);
+		data += 4;
+
+		sum ^= word;
+		if (i & 0x01)
+			lineSum[0] ^= word;
+		if (i & 0x02)
+			lineSum[1] ^= word;
+		if (i & 0x04)
+			lineSum[2] ^= word;
+		if (i & 0x08)
+			lineSum[3] ^= word;
+		if (i & 0x10)
+			lineSum[4] ^= word;
+		if (i & 0x20)
+			lineSum[5] ^= word;
 	}
 
-	/*
-	 * At this point, we have the line parities, and the column sum. First, We
-	 * must caculate the parity group values on the column sum.
-	 */
-	for (i = 0; i < 8; i++) {
-		if (columnSum & 1) {
-			evenColumnCode ^= (7 - i);
-			oddColumnCode ^= i;
-		}
-		columnSum >>= 1;
-	}
+	parity = WordParity(sum);
+
+	/* Column sum: xor of all the bytes */
+	columnSum = (sum ^ (sum >> 8) ^ (sum >> 16) ^ (sum >> 24)) & 0xff;
 
 	/*
-	 * Now, we must interleave the parity values, to obtain the following layout:
+	 * Interleave the parity values, to obtain the following layout:
 	 * Code[0] = Line1
 	 * Code[1] = Line2
 	 * Code[2] = Column
@@ -129,37 +148,42 @@ static void Compute256(const unsigned char *data, unsigned char *code)
 	code[1] = 0;
 	code[2] = 0;
 
-	for (i = 0; i < 4; i++) {
-		code[0] <<= 2;
-		code[1] <<= 2;
-		code[2] <<= 2;
+	/* Line 1: P128' P128 .. P16' P16 */
+	for (i = 6; i > 2; i--) {
+		odd = WordParity(lineSum[i - 1]);
+		even = odd ^ parity;
+		code[0] = (code[0] << 2) | (odd << 1) | even;
+	}
 
-		/* Line 1 */
-		if ((oddLineCode & 0x80) != 0)
-			code[0] |= 2;
+	/* Line 2: P8' P8 P4' P4 from the words, P2' P2 P1' P1 in the words */
+	for (i = 2; i > 0; i--) {
+		odd = WordParity(lineSum[i - 1]);
+		even = odd ^ parity;
+		code[1] = (code[1] << 2) | (odd << 1) | even;
+	}
 
-		if ((evenLineCode & 0x80) != 0)
-			code[0] |= 1;
+	odd = WordParity(sum & 0xffff0000);
+	even = odd ^ parity;
+	code[1] = (code[1] << 2) | (odd << 1) | even;
 
-		/* Line 2 */
-		if ((oddLineCode & 0x08) != 0)
-			code[1] |= 2;
+	odd = WordParity(sum & 0xff00ff00);
+	even = odd ^ parity;
+	code[1] = (code[1] << 2) | (odd << 1) | even;
 
-		if ((evenLineCode & 0x08) != 0)
-			code[1] |= 1;
+	/* Column: P4' P4 P2' P2 P1' P1 */
+	odd = ByteParity[columnSum & 0xf0];
+	even = ByteParity[columnSum & 0x0f];
+	code[2] = (odd << 1) | even;
 
-		/* Column */
-		if ((oddColumnCode & 0x04) != 0)
-			code[2] |= 2;
+	odd = ByteParity[columnSum & 0xcc];
+	even = ByteParity[columnSum & 0x33];
+	code[2] = (code[2] << 2) | (odd << 1) | even;
 
-		if ((evenColumnCode & 0x04) != 0)
-			code[2] |= 1;
+	odd = ByteParity[columnSum & 0xaa];
+	even = ByteParity[columnSum & 0x55];
+	code[2] = (code[2] << 2) | (odd << 1) | even;
 
-		oddLineCode <<= 1;
-		evenLineCode <<= 1;
-		oddColumnCode <<= 1;
-		evenColumnCode <<= 1;
-	}
+	code[2] <<= 2;
 
 	/* Invert codes (linux compatibility) */
 	code[0] = ~code[0];
@@ -27,6 +27,7 @@
  */
 #include "common.h"
 #include "hardware.h"
+#include "board.h"
 #include "arch/at91_pmc.h"
 #include "string.h"
 #include "slowclk.h"
@@ -35,6 +36,8 @@
 #include "sdcard.h"
 #include "fdt.h"
 #include "onewire_info.h"
+#include "mmu.h"
+#include "bootstage.h"
 
 #include "debug.h"
 
@@ -108,6 +111,27 @@ static int setup_dt_blob(void *blob)
 	return 0;
 }
 
+#ifdef CONFIG_SDCARD_INITRD
+static int setup_dt_initrd(void *blob, struct image_info *image)
+{
+	unsigned int start = (unsigned int)image->initrd_dest;
+	unsigned int end = start + image->initrd_length;
+	unsigned int value;
+	int ret;
+
+	dbg_log(1, "DT: initrd at %d, %d bytes\n\r",
+					start, image->initrd_length);
+
+	value = swap_uint32(start);
+	ret = fixup_chosen_property(blob, "linux,initrd-start", &value, 4);
+	if (ret)
+		return ret;
+
+	value = swap_uint32(end);
+	return fixup_chosen_property(blob, "linux,initrd-end", &value, 4);
+}
+#endif
+
 static void setup_boot_params(void) {}
 
 #else
@@ -257,12 +281,139 @@ struct kernel_image_header {
 	unsigned char	name[32];
 };
 
+/*
+ * Return the length of the uImage at addr, header included,
+ * or -1 if there is no valid kernel image header.
+ */
+int kernel_size(unsigned char *addr)
+{
+	struct kernel_image_header *image_header
+				= (struct kernel_image_header *)addr;
+	unsigned int magic_number;
+
+	magic_number = swap_uint32(image_header->magic);
+	if (magic_number != KERNEL_IMAGE_MAGIC) {
+		dbg_log(1, "** Bad image magic number found: %d\n\r",
+						magic_number);
+		return -1;
+	}
+
+	return swap_uint32(image_header->size)
+			+ sizeof(struct kernel_image_header);
+}
+
+/*
+ * Return the length of the image of type flag (KERNEL_IMAGE or DT_BLOB)
+ * whose header is at addr, or -1 if the header is not valid or the image
+ * does not fit in length bytes.
+ */
+int image_header_length(unsigned char *addr,
+			unsigned int length,
+			unsigned char flag)
+{
+	int size = -1;
+
+	if (flag == KERNEL_IMAGE)
+		size = kernel_size(addr);
+#ifdef CONFIG_OF_LIBFDT
+	else if (!check_dt_blob_valid((void *)addr))
+		size = of_get_dt_total_size((void *)addr);
+#endif
+
+	if (size < 0) {
+		dbg_log(1, "No valid image header found\n\r");
+		return -1;
+	}
+
+	if ((unsigned int)size > length) {
+		dbg_log(1, "Image size: %d exceeds the length: %d\n\r",
+				size, length);
+		return -1;
+	}
+
+	return size;
+}
+
+/*
+ * End of the memory the images may be loaded to: the memory bank handed
+ * to the kernel, less the translation table at the end of the DDR when
+ * the MMU is on.
+ */
+unsigned int os_mem_end(void)
+{
+	unsigned int end = OS_MEM_BANK + OS_MEM_SIZE;
+
+#ifdef CONFIG_MMU
+	if (end > CONFIG_SYS_MMU_TTB)
+		end = CONFIG_SYS_MMU_TTB;
+#endif
+	return end;
+}
+
+/* Does [start, end) cover any byte of the length bytes at addr? */
+static int image_overlaps(unsigned int start, unsigned int end,
+			unsigned char *addr, unsigned int length)
+{
+	unsigned int base = (unsigned int)addr;
+
+	if (!length)
+		length = 1;
+
+	return (start < base + length) && (base < end);
+}
+
+/*
+ * Return where the uImage whose header is at image->dest has to be loaded
+ * so that its payload lands right at the load address, with the header
+ * just in front of it. length is the number of bytes the loader will
+ * write, rounded up to its page or sector size.
+ * If there is no room for the header, or if the image would run over the
+ * device tree blob, the initial ramdisk, or the end of the memory, keep
+ * image->dest and let load_kernel() relocate the payload.
+ */
+unsigned char *kernel_image_dest(struct image_info *image,
+				unsigned int length)
+{
+	struct kernel_image_header *image_header
+				= (struct kernel_image_header *)image->dest;
+	unsigned int load_addr = swap_uint32(image_header->load);
+	unsigned int start, end;
+
+	if (load_addr < (OS_MEM_BANK + sizeof(struct kernel_image_header)))
+		return image->dest;
+
+	start = load_addr - sizeof(struct kernel_image_header);
+	end = os_mem_end();
+	if ((start >= end) || (length > end - start)) {
+		dbg_log(1, "Image: %d bytes at %d run past %d\n\r",
+							length, start, end);
+		return image->dest;
+	}
+	end = start + length;
+
+	if (image->of && image_overlaps(start, end,
+					image->of_dest, image->of_length)) {
+		dbg_log(1, "Image: %d bytes at %d overlap the dt blob\n\r",
+							length, start);
+		return image->dest;
+	}
+
+	if (image->initrd && image_overlaps(start, end,
+					image->initrd_dest, 0)) {
+		dbg_log(1, "Image: %d bytes at %d overlap the initrd\n\r",
+							length, start);
+		return image->dest;
+	}
+
+	return (unsigned char *)start;
+}
+
 int load_kernel(struct image_info *image)
 {
 	struct kernel_image_header *image_header;
 	unsigned int load_addr, image_size;
 	unsigned int magic_number;
-	unsigned int jump_addr = (unsigned int)image->dest;
+	unsigned int jump_addr;
 	unsigned int r2;
 	unsigned int mach_type;
 	int ret;
@@ -283,10 +434,7 @@ int load_kernel(struct image_info *image)
 	if (ret != 0)
 		return ret;
 
-#ifdef CONFIG_SCLK
-	slowclk_switch_osc32();
-#endif
-
+	jump_addr = (unsigned int)image->dest;
 	image_header = (struct kernel_image_header *)jump_addr;
 	magic_number = swap_uint32(image_header->magic);
 	dbg_log(1, "\n\rImage magic: %d is found\n\r", magic_number);
@@ -307,19 +455,36 @@ int load_kernel(struct image_info *image)
 	kernel_entry = (void (*)(int, int, unsigned int))
 					swap_uint32(image_header->entry_point);
 
-	dbg_log(1, "Relocating kernel image, dest: %d, src: %d\n\r",
-		load_addr, jump_addr + sizeof(struct kernel_image_header));
+	if (load_addr != jump_addr + sizeof(struct kernel_image_header)) {
+		bootstage_mark("kernel_relocate");
+
+		dbg_log(1, "Relocating kernel image, dest: %d, src: %d\n\r",
+			load_addr, jump_addr + sizeof(struct kernel_image_header));
 
-	memcpy((void *)load_addr, (void *)(jump_addr
-			+ sizeof(struct kernel_image_header)), image_size);
+		memcpy((void *)load_addr, (void *)(jump_addr
+				+ sizeof(struct kernel_image_header)), image_size);
 
-	dbg_log(1, " ...... %d bytes data transferred\n\r", image_size);
+		dbg_log(1, " ...... %d bytes data transferred\n\r",
+							image_size);
+	} else
+		dbg_log(1, "Kernel image loaded in place at: %d\n\r",
+							load_addr);
 
 	if (image->of) {
+		bootstage_mark("fdt_fixup");
+
 		ret = setup_dt_blob((char *)image->of_dest);
 		if (ret)
 			return ret;
 
+#ifdef CONFIG_SDCARD_INITRD
+		if (image->initrd) {
+			ret = setup_dt_initrd(image->of_dest, image);
+			if (ret)
+				return ret;
+		}
+#endif
+
 		mach_type = 0xffffffff;
 		r2 = (unsigned int)image->of_dest;
 	} else {
@@ -329,9 +494,28 @@ int load_kernel(struct image_info *image)
 		r2 = (unsigned int)(OS_MEM_BANK + 0x100);
 	}
 
+#ifdef CONFIG_SCLK
+	/* as late as possible, to give the 32K oscillator time to start */
+	bootstage_mark("slowclk_switch");
+	slowclk_switch_osc32();
+#endif
+
+	bootstage_mark("kernel_jump");
+#ifdef CONFIG_OF_LIBFDT
+	if (image->of) {
+		bootstage_fixup_dt((void *)image->of_dest);
+		nand_stats_fixup_dt((void *)image->of_dest);
+	}
+#endif
+	bootstage_report();
+
 	dbg_log(1, "\n\rStarting linux kernel ..., machid: %d\n\r\n\r",
 							mach_type);
 
+#ifdef CONFIG_MMU
+	mmu_disable();
+#endif
+
 	kernel_entry(0, mach_type, r2);
 
 	return 0;
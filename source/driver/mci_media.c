@@ -81,6 +81,12 @@ static const struct sd_command	sd_command_table[] =  {
 		.cmdreg		= (16 | AT91C_MCI_RSPTYP_48
 					| AT91C_MCI_MAXLAT_64),
 	},
+	/* CMD23 */
+	{
+		.cmd		= SD_CMD_SET_BLOCK_COUNT,
+		.cmdreg		= (23 | AT91C_MCI_RSPTYP_48
+					| AT91C_MCI_MAXLAT_64),
+	},
 	/* CMD12 */
 	{
 		.cmd		= SD_CMD_STOP_TRANSMISSION,
@@ -1081,6 +1087,9 @@ static int sd_initialization(struct sd_card *sdcard)
 
 	sdcard->bus_width_support = (sdcard->reg->scr[0] >> 16) & 0x0f;
 
+	/* CMD_SUPPORT: SET_BLOCK_COUNT is SCR bit 33 */
+	sdcard->set_block_count = (sdcard->reg->scr[0] >> 1) & 0x01;
+
 #ifdef CONFIG_SDCARD_HS
 	unsigned int version;
 	version = (sdcard->reg->scr[0] >> 24) & 0x0f;
@@ -1163,6 +1172,10 @@ static int mmc_initialization(struct sd_card *sdcard)
 	if (ret)
 		return ret;
 
+	/* SET_BLOCK_COUNT is mandatory since MMC 3.1 */
+	if (sdcard->sd_spec_version >= MMC_VERSION_3)
+		sdcard->set_block_count = 1;
+
 	if (sdcard->sd_spec_version >= MMC_VERSION_4) {
 		ret = mmc_detect_buswidth(sdcard);
 		if (ret)
@@ -1240,9 +1253,31 @@ static int sd_cmd_set_blocklen(struct sd_card *sdcard,
 	struct sd_command *command = sdcard->command;
 	int ret;
 
+	/* The card keeps the block length until the next power cycle */
+	if (sdcard->block_len == block_len)
+		return 0;
+
 	command->cmd = SD_CMD_SET_BLOCKLEN;
 	command->argu = block_len;
 
+	ret = sd_send_command(command);
+	if (ret)
+		return ret;
+
+	sdcard->block_len = block_len;
+
+	return 0;
+}
+
+static int sd_cmd_set_block_count(struct sd_card *sdcard,
+					unsigned int block_count)
+{
+	struct sd_command *command = sdcard->command;
+	int ret;
+
+	command->cmd = SD_CMD_SET_BLOCK_COUNT;
+	command->argu = block_count & 0xffff;
+
 	ret = sd_send_command(command);
 	if (ret)
 		return ret;
@@ -1275,16 +1310,33 @@ static int sd_cmd_read_multiple_block(struct sd_card *sdcard,
 {
 	unsigned int block_len = sdcard->read_bl_len;
 	struct sd_command *command = sdcard->command;
+#ifdef CONFIG_SDCARD_DMA
+	unsigned int dma;
+#endif
 	int ret;
 
 	command->cmd = SD_CMD_READ_MULTIPLE_BLOCK;
 	command->argu = (sdcard->highcapacity_card) ? start : start * block_len;
 
+#ifdef CONFIG_SDCARD_DMA
+	dma = (at91_mci_dma_start(buf, block_count, block_len) == 0);
+#endif
+
 	ret = sd_send_command(command);
-	if (ret)
+	if (ret) {
+#ifdef CONFIG_SDCARD_DMA
+		if (dma)
+			at91_mci_dma_stop();
+#endif
 		return 0;
+	}
 
-	ret = at91_mci_read_blocks(buf, block_count, block_len);
+#ifdef CONFIG_SDCARD_DMA
+	if (dma)
+		ret = at91_mci_dma_wait(buf, block_count, block_len);
+	else
+#endif
+		ret = at91_mci_read_blocks(buf, block_count, block_len);
 	if (ret)
 		return 0;
 
@@ -1313,7 +1365,11 @@ static int sd_cmd_read_single_block(struct sd_card *sdcard,
 	return 1;
 }
 
+#ifdef CONFIG_SDCARD_DMA
+#define SUPPORT_MAX_BLOCKS	MCI_DMA_MAX_BLOCKS
+#else
 #define SUPPORT_MAX_BLOCKS	65535
+#endif
 unsigned int sdcard_block_read(unsigned int start,
 				unsigned int block_count,
 				void *buf)
@@ -1343,15 +1399,26 @@ unsigned int sdcard_block_read(unsigned int start,
 		 * Set the block length (in bytes)
 		 * Set the block count
 		 */
-		at91_mci_set_blkr(block_count, block_len);
+		at91_mci_set_blkr(blocks, block_len);
+
+		if ((blocks > 1) && sdcard->set_block_count) {
+			/*
+			 * Pre-defined multiple block read: the card ends
+			 * the transfer after the block count by itself.
+			 */
+			ret = sd_cmd_set_block_count(sdcard, blocks);
+			if (ret)
+				return 0;
 
-		if (blocks > 1) {
+			blocks_read = sd_cmd_read_multiple_block(sdcard,
+							buf, start, blocks);
+		} else if (blocks > 1) {
 			blocks_read = sd_cmd_read_multiple_block(sdcard,
 							buf, start, blocks);
 
 			ret = sd_cmd_stop_transmission(sdcard);
 			if (ret)
-				return ret;
+				return 0;
 		} else {
 			blocks_read = sd_cmd_read_single_block(sdcard,
 							buf, start);
@@ -0,0 +1,101 @@
+/* ----------------------------------------------------------------------------
+ *         ATMEL Microcontroller Software Support
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2013, Atmel Corporation
+
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the disclaimer below.
+ *
+ * Atmel's name may not be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * DISCLAIMER: THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "common.h"
+#include "hardware.h"
+#include "board.h"
+#include "mmu.h"
+#include "debug.h"
+
+/* Short-descriptor section entry */
+#define TTB_SECT		(0x2 << 0)
+#define TTB_SECT_B		(1 << 2)
+#define TTB_SECT_C		(1 << 3)
+#define TTB_SECT_XN		(1 << 4)
+#define TTB_SECT_AP_RW		(0x3 << 10)
+
+#define TTB_SECT_STRONGLY_ORDERED	(TTB_SECT | TTB_SECT_AP_RW \
+					| TTB_SECT_XN)
+#define TTB_SECT_WRITE_BACK		(TTB_SECT | TTB_SECT_AP_RW \
+					| TTB_SECT_C | TTB_SECT_B)
+
+#define TTB_SECTION_SHIFT	20
+#define TTB_SECTION_SIZE	(1 << TTB_SECTION_SHIFT)
+#define TTB_ENTRIES		4096
+
+extern void mmu_on(unsigned int ttb);
+extern void mmu_off(void);
+
+static void mmu_map_sections(unsigned int *ttb,
+				unsigned int addr,
+				unsigned int size,
+				unsigned int attr)
+{
+	unsigned int section = addr >> TTB_SECTION_SHIFT;
+	unsigned int count = size >> TTB_SECTION_SHIFT;
+
+	while (count--) {
+		ttb[section] = (section << TTB_SECTION_SHIFT) | attr;
+		section++;
+	}
+}
+
+void mmu_enable(void)
+{
+	unsigned int *ttb = (unsigned int *)CONFIG_SYS_MMU_TTB;
+	unsigned int section;
+
+	/* Everything is strongly-ordered and never executed by default */
+	for (section = 0; section < TTB_ENTRIES; section++)
+		ttb[section] = (section << TTB_SECTION_SHIFT)
+					| TTB_SECT_STRONGLY_ORDERED;
+
+	/*
+	 * The boot area (SRAM0 remapped at 0, where the code and the data
+	 * run), the ROM (PMECC lookup tables) and the SRAM (stack)
+	 */
+	mmu_map_sections(ttb, AT91C_BASE_BOOT,
+			TTB_SECTION_SIZE, TTB_SECT_WRITE_BACK);
+	mmu_map_sections(ttb, AT91C_BASE_ROM,
+			TTB_SECTION_SIZE, TTB_SECT_WRITE_BACK);
+	mmu_map_sections(ttb, AT91C_BASE_SRAM0,
+			TTB_SECTION_SIZE, TTB_SECT_WRITE_BACK);
+
+	/* The DDR, where the images are loaded */
+	mmu_map_sections(ttb, AT91C_BASE_DDRCS,
+			CONFIG_SYS_DDR_SIZE, TTB_SECT_WRITE_BACK);
+
+	dbg_log(1, "MMU: Enable the MMU and caches, table at: %d\n\r",
+						(unsigned int)ttb);
+
+	mmu_on((unsigned int)ttb);
+}
+
+void mmu_disable(void)
+{
+	mmu_off();
+}
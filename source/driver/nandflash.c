@@ -30,14 +30,24 @@
 #include "board.h"
 #include "arch/at91_pio.h"
 #include "arch/at91_nand_ecc.h"
+#include "arch/at91_dmac.h"
+#include "arch/at91_nfc.h"
 #include "gpio.h"
 
+#include "dbgu.h"
 #include "debug.h"
 
 #include "nand.h"
+#include "nandflash.h"
 #include "hamming.h"
+#include "pmecc.h"
 #include "timer.h"
 #include "div.h"
+#include "fdt.h"
+#include "bootstage.h"
+#include "string.h"
+#include "dmac.h"
+#include "mmu.h"
 
 static struct nand_chip nand_ids[] = {
 	/* Samsung K9F2G08U0M 256MB */
@@ -63,40 +73,10 @@ static struct nand_chip nand_ids[] = {
 
 #ifdef CONFIG_USE_PMECC
 
-#define TT_MAX			25
+#define PMECC_MAX_SECTORS	8
+#define PMECC_REM_SIZE		0x40	/* remainders of a sector */
 
-/* The PMECC descripter structure */
-struct _PMECC_paramDesc_struct {
-	unsigned int pageSize;
-	unsigned int spareSize;
-	unsigned int sectorSize;	// 0 for 512, 1 for 1024 bytes, like in PMECCFG register
-	unsigned int errBitNbrCapability;
-	unsigned int eccSizeByte;
-	unsigned int eccStartAddress;
-	unsigned int eccEndAddress;
-
-	unsigned int nandWR;
-	unsigned int spareEna;
-	unsigned int modeAuto;
-	unsigned int clkCtrl;
-	unsigned int interrupt;
-
-	int tt;
-	int mm;
-	int nn;
-
-	short *alpha_to;
-	short *index_of;
-
-	short partialSyn[100];
-	short si[100];
-
-	/* sigma table */
-	short smu[TT_MAX + 2][2 * TT_MAX + 1];
-	/* polynom order */
-	short lmu[TT_MAX + 1];
-
-} PMECC_paramDesc;
+struct _PMECC_paramDesc_struct PMECC_paramDesc;
 
 static int pmecc_readl(unsigned int reg)
 {
@@ -413,6 +393,7 @@ static unsigned short onfi_crc16(unsigned short crc,
 #define ONFI_PARAMS_SIZE		256
 
 #define PARAMS_OFFSET_BUSWIDTH		6
+#define PARAMS_OFFSET_OPT_CMD		8
 #define PARAMS_OFFSET_MODEL		49
 #define PARAMS_OFFSET_JEDEC_ID		64
 #define PARAMS_OFFSET_PAGESIZE		80
@@ -420,10 +401,14 @@ static unsigned short onfi_crc16(unsigned short crc,
 #define PARAMS_OFFSET_BLOCKSIZE		92
 #define PARAMS_OFFSET_NBBLOCKS		96
 #define PARAMS_OFFSET_ECC_BITS		112
+#define PARAMS_OFFSET_TIMING_MODES	129
 #define PARAMS_OFFSET_CRC		254
 
 #define ONFI_CRC_BASE			0x4F4E
 
+#define ONFI_OPT_CMD_READ_CACHE		(0x01 << 1)
+#define ONFI_OPT_CMD_SET_FEATURES	(0x01 << 2)
+
 static int nandflash_detect_onfi(struct nand_chip *chip)
 {
 	unsigned char onfi_ind[4];
@@ -487,6 +472,12 @@ static int nandflash_detect_onfi(struct nand_chip *chip)
 	chip->oobsize	= *(unsigned char *)(p + PARAMS_OFFSET_OOBSIZE);
 	chip->buswidth	= (*(unsigned char *)(p + PARAMS_OFFSET_BUSWIDTH))
 								& 0x01;
+	chip->read_cache = (*(unsigned short *)(p + PARAMS_OFFSET_OPT_CMD)
+					& ONFI_OPT_CMD_READ_CACHE) ? 1 : 0;
+	chip->set_features = (*(unsigned short *)(p + PARAMS_OFFSET_OPT_CMD)
+					& ONFI_OPT_CMD_SET_FEATURES) ? 1 : 0;
+	chip->timing_modes = p[PARAMS_OFFSET_TIMING_MODES]
+				| (p[PARAMS_OFFSET_TIMING_MODES + 1] << 8);
 
 	manf_id = *(unsigned char *)(p + PARAMS_OFFSET_JEDEC_ID);
 	dev_id = *(unsigned char *)(p + PARAMS_OFFSET_MODEL);
@@ -559,7 +550,133 @@ static void nand_info_init(struct nand_info *nand, struct nand_chip *chip)
 	nand->buswidth = chip->buswidth;
 	if (nand->buswidth)
 		nand->ecclayout->badblockpos *= 2;
+	/* READ CACHE SEQUENTIAL/END, only known from the ONFI parameters */
+	nand->read_cache = chip->read_cache;
+	if (nand->read_cache)
+		dbg_log(1, "NAND: Read cache supported\n\r");
+}
+
+#ifdef CONFIG_NANDFLASH_ONFI_TIMING
+#define ONFI_TIMING_MODES	6
+
+/* tRC, tRP, tREH, tREA, tWC, tWP, tWH of the ONFI timing modes 0 to 5 */
+static const struct nand_timings onfi_timings[ONFI_TIMING_MODES] = {
+	{100, 50, 30, 40, 100, 50, 30},
+	{50, 25, 15, 30, 45, 25, 15},
+	{35, 17, 15, 25, 35, 17, 15},
+	{30, 15, 10, 20, 30, 15, 10},
+	{25, 12, 10, 20, 25, 12, 10},
+	{20, 10, 7, 16, 20, 10, 7},
+};
+
+static void write_word(unsigned short data)
+{
+	writew(data, (unsigned long)CONFIG_SYS_NAND_BASE);
+}
+
+/*
+ * The feature commands, address and parameters only use the low 8 bits
+ * of a 16 bits bus. The chip latches a parameter at least tADL (200 ns
+ * in timing mode 0) after the address cycle.
+ */
+static void nand_set_feature(struct nand_chip *chip,
+			unsigned char address, unsigned char *param)
+{
+	unsigned char i;
+
+	nand_cs_enable();
+
+	if (chip->buswidth) {
+		nand_command16(CMD_SET_FEATURE);
+		nand_address16(address);
+	} else {
+		nand_command(CMD_SET_FEATURE);
+		nand_address(address);
+	}
+
+	udelay(1);	/* tADL */
+
+	for (i = 0; i < 4; i++) {
+		if (chip->buswidth)
+			write_word(param[i]);
+		else
+			write_byte(param[i]);
+	}
+
+	nand_wait_ready();
+
+	nand_cs_disable();
+}
+
+static void nand_get_feature(struct nand_chip *chip,
+			unsigned char address, unsigned char *param)
+{
+	unsigned char i;
+
+	nand_cs_enable();
+
+	if (chip->buswidth) {
+		nand_command16(CMD_GET_FEATURE);
+		nand_address16(address);
+	} else {
+		nand_command(CMD_GET_FEATURE);
+		nand_address(address);
+	}
+
+	nand_wait_ready();
+
+	if (chip->buswidth)
+		nand_command16(CMD_READ_1);
+	else
+		nand_command(CMD_READ_1);
+
+	for (i = 0; i < 4; i++) {
+		if (chip->buswidth)
+			param[i] = read_word() & 0xff;
+		else
+			param[i] = read_byte();
+	}
+
+	nand_cs_disable();
+}
+
+/*
+ * Switch the chip to the fastest timing mode it supports, up to
+ * CONFIG_SYS_NAND_MAX_TIMING_MODE, then let the board retune the SMC.
+ * The chip is kept in mode 0 and the SMC on the board timings if
+ * anything fails.
+ */
+static int nand_init_timing_mode(struct nand_chip *chip)
+{
+	unsigned char param[4] = {0, 0, 0, 0};
+	int mode;
+
+	for (mode = CONFIG_SYS_NAND_MAX_TIMING_MODE; mode > 0; mode--)
+		if (chip->timing_modes & (1 << mode))
+			break;
+
+	if (mode == 0)
+		return 0;
+
+	if (chip->set_features) {
+		param[0] = mode;
+		nand_set_feature(chip, FEATURE_TIMING_MODE, param);
+
+		nand_get_feature(chip, FEATURE_TIMING_MODE, param);
+		if ((param[0] & 0x0f) != mode) {
+			dbg_log(1, "NAND: Failed to set timing mode %d\n\r",
+									mode);
+			return -1;
+		}
+	}
+
+	nandflash_config_timings(&onfi_timings[mode]);
+
+	dbg_log(1, "NAND: ONFI timing mode: %d\n\r", mode);
+
+	return 0;
 }
+#endif
 
 static void nandflash_reset(void)
 {
@@ -598,11 +715,200 @@ static int nandflash_get_type(struct nand_info *nand)
 	else
 		nandflash_config_buswidth(1);
 
+#ifdef CONFIG_NANDFLASH_ONFI_TIMING
+	nand_init_timing_mode(chip);
+#endif
+
 	return 0;
 }
 
+#ifdef CONFIG_NANDFLASH_STATS
+/*
+ * Bitflip statistics of the blocks read: the blocks which had corrected
+ * bits or read retries, with the most bits corrected in one ECC sector.
+ */
+#define NAND_STATS_BLOCKS	32
+
+#if defined(CONFIG_USE_PMECC)
+#define NAND_STATS_STRENGTH	PMECC_ERROR_CORR_BITS
+#define NAND_STATS_SECTOR	PMECC_SECTOR_SIZE
+#elif defined(CONFIG_ENABLE_SW_ECC)
+#define NAND_STATS_STRENGTH	1
+#define NAND_STATS_SECTOR	256
+#else
+#define NAND_STATS_STRENGTH	0
+#define NAND_STATS_SECTOR	0
+#endif
+
+struct nand_block_stats {
+	unsigned int	block;
+	unsigned int	max_bits;	/* most bits corrected in a sector */
+	unsigned int	total_bits;	/* bits corrected in the block */
+	unsigned int	retries;	/* block reads retried */
+};
+
+static struct nand_block_stats nand_stats[NAND_STATS_BLOCKS];
+static unsigned int nand_stats_count;
+static unsigned int nand_stats_block;
+
+/* Bits corrected by the current read attempt, not committed yet */
+static unsigned int nand_stats_max_bits;
+static unsigned int nand_stats_total_bits;
+
+/* Start a read attempt of block, dropping the counts of a failed one */
+static void nand_stats_set_block(unsigned int block)
+{
+	nand_stats_block = block;
+	nand_stats_max_bits = 0;
+	nand_stats_total_bits = 0;
+}
+
+static struct nand_block_stats *nand_stats_get(void)
+{
+	struct nand_block_stats *stats;
+	unsigned int i;
+
+	for (i = 0; i < nand_stats_count; i++)
+		if (nand_stats[i].block == nand_stats_block)
+			return &nand_stats[i];
+
+	if (nand_stats_count == NAND_STATS_BLOCKS)
+		return 0;
+
+	stats = &nand_stats[nand_stats_count++];
+	memset(stats, 0, sizeof(*stats));
+	stats->block = nand_stats_block;
+
+	return stats;
+}
+
+/* Record the bits corrected in an ECC sector by the current attempt */
+static void nand_stats_bits(unsigned int bits)
+{
+	if (bits > nand_stats_max_bits)
+		nand_stats_max_bits = bits;
+	nand_stats_total_bits += bits;
+}
+
+/* The current attempt succeeded: add its counts to the block */
+static void nand_stats_commit(void)
+{
+	struct nand_block_stats *stats;
+
+	if (!nand_stats_total_bits)
+		return;
+
+	stats = nand_stats_get();
+	if (stats) {
+		if (nand_stats_max_bits > stats->max_bits)
+			stats->max_bits = nand_stats_max_bits;
+		stats->total_bits += nand_stats_total_bits;
+	}
+
+	nand_stats_max_bits = 0;
+	nand_stats_total_bits = 0;
+}
+
+static void nand_stats_retry(void)
+{
+	struct nand_block_stats *stats = nand_stats_get();
+
+	if (stats)
+		stats->retries++;
+}
+
+/* Straight to the DBGU: dbg_log() is compiled out without CONFIG_DEBUG */
+static void nand_stats_report(void)
+{
+	unsigned int i;
+
+	for (i = 0; i < nand_stats_count; i++) {
+		dbgu_print("NAND: Block ");
+		dbgu_print_dec(nand_stats[i].block);
+		dbgu_print(": ");
+		dbgu_print_dec(nand_stats[i].total_bits);
+		dbgu_print(" bits corrected, max ");
+		dbgu_print_dec(nand_stats[i].max_bits);
+		dbgu_print(" per sector, ");
+		dbgu_print_dec(nand_stats[i].retries);
+		dbgu_print(" retries\n\r");
+	}
+}
+
+#ifdef CONFIG_OF_LIBFDT
+int nand_stats_fixup_dt(void *blob)
+{
+	unsigned int buf[2 + NAND_STATS_BLOCKS * 4];
+	unsigned int len = 0;
+	unsigned int i;
+
+	buf[len++] = swap_uint32(NAND_STATS_STRENGTH);
+	buf[len++] = swap_uint32(NAND_STATS_SECTOR);
+
+	for (i = 0; i < nand_stats_count; i++) {
+		buf[len++] = swap_uint32(nand_stats[i].block);
+		buf[len++] = swap_uint32(nand_stats[i].max_bits);
+		buf[len++] = swap_uint32(nand_stats[i].total_bits);
+		buf[len++] = swap_uint32(nand_stats[i].retries);
+	}
+
+	return fixup_chosen_property(blob, "nand-bitflips", buf, len * 4);
+}
+#endif
+#else
+static inline void nand_stats_set_block(unsigned int block)
+{
+}
+
+static inline void nand_stats_bits(unsigned int bits)
+{
+}
+
+static inline void nand_stats_commit(void)
+{
+}
+
+static inline void nand_stats_retry(void)
+{
+}
+
+static inline void nand_stats_report(void)
+{
+}
+#endif /* #ifdef CONFIG_NANDFLASH_STATS */
+
 #ifdef CONFIG_USE_PMECC
 
+#ifdef CONFIG_PMECC_SRAM_TABLES
+/* Primitive polynomial of GF(2^13), the one of the ROM tables */
+#define PMECC_GF_POLY_13	0x201b
+
+/*
+ * Build the alpha_to (power to element) and index_of (element to power)
+ * tables of GF(2^mm) in the internal SRAM, with the content of the ROM ones.
+ */
+static void build_gf_tables(struct _PMECC_paramDesc_struct *pmecc_params)
+{
+	short *alpha_to = (short *)CONFIG_SYS_PMECC_TABLES_ADDR;
+	short *index_of = alpha_to + (pmecc_params->nn + 1);
+	unsigned int x = 1;
+	int i;
+
+	for (i = 0; i < pmecc_params->nn; i++) {
+		alpha_to[i] = x;
+		index_of[x] = i;
+		x <<= 1;
+		if (x & (1 << pmecc_params->mm))
+			x ^= PMECC_GF_POLY_13;
+	}
+	alpha_to[pmecc_params->nn] = 1;
+	index_of[0] = -1;
+
+	pmecc_params->alpha_to = alpha_to;
+	pmecc_params->index_of = index_of;
+}
+#endif
+
 static int init_pmecc_descripter(struct _PMECC_paramDesc_struct *pmecc_params,
 				struct nand_info *nand)
 {
@@ -632,10 +938,14 @@ static int init_pmecc_descripter(struct _PMECC_paramDesc_struct *pmecc_params,
 		pmecc_params->nn = (1 << pmecc_params->mm) - 1;
 
 		if (PMECC_SECTOR_SIZE == 512) {
+#ifdef CONFIG_PMECC_SRAM_TABLES
+			build_gf_tables(pmecc_params);
+#else
 			pmecc_params->alpha_to = (short *)(AT91C_BASE_ROM
 						+ CONFIG_LOOKUP_TABLE_ALPHA_OFFSET);
 			pmecc_params->index_of = (short *)(AT91C_BASE_ROM
 						+ CONFIG_LOOKUP_TABLE_INDEX_OFFSET);
+#endif
 		} else {
 			pmecc_params->alpha_to = (short *)(AT91C_BASE_ROM
 						+ CONFIG_LOOKUP_TABLE_ALPHA_OFFSET_1024);
@@ -733,6 +1043,8 @@ static int init_pmecc(struct nand_info *nand)
 	if (init_pmecc_descripter(&PMECC_paramDesc, nand) != 0)
 		return -1;
 
+	pmecc_init_syn_table(&PMECC_paramDesc);
+
 	dbg_log(1, "NAND: Initialize PMECC params, cap: %d, sector: %d\n\r",
 			PMECC_ERROR_CORR_BITS, PMECC_SECTOR_SIZE);
 
@@ -779,11 +1091,10 @@ static void write_row_address(struct nand_info *nand,
 
 #ifdef CONFIG_USE_PMECC
 static int check_pmecc_ecc_data(struct nand_info *nand,
-				unsigned char *buffer)
+				unsigned char *oob)
 {
 	unsigned int i;
-	unsigned char *ecc_data = buffer + nand->pagesize
-				+ nand->ecclayout->eccpos[0];
+	unsigned char *ecc_data = oob + nand->ecclayout->eccpos[0];
 
 	for (i = 0; i < nand->ecclayout->eccbytes; i++)
 		if (*ecc_data++ != 0xff)
@@ -797,18 +1108,19 @@ static int check_pmecc_ecc_data(struct nand_info *nand,
 
 /*
  * \brief Build the pseudo syndromes table
+ * \param pRemainders Address of the PMECC remainders (or of a copy).
  * \param pPmeccDescriptor Pointer to a PMECC_paramDesc instance.
  * \param sector Targetted sector.
  */
 
-static void GenSyn(unsigned long pPMECC,
+static void GenSyn(unsigned long pRemainders,
 		struct _PMECC_paramDesc_struct *pPmeccDescriptor,
 		unsigned int sector)
 {
 	short *pRemainer;
 	unsigned int index;
 
-	pRemainer = (short *) (pPMECC + PMECC_REM + (sector * 0x40));
+	pRemainer = (short *) (pRemainders + (sector * PMECC_REM_SIZE));
 
 	for (index = 0; index < pPmeccDescriptor->tt; index++)
 		/* Fill odd syndromes */
@@ -816,225 +1128,6 @@ static void GenSyn(unsigned long pPMECC,
 						= pRemainer[index];
 }
 
-/**
- * \brief The substitute function evaluates the polynomial remainder,
- * with different values of the field primitive elements.
- * \param pPmeccDescriptor Pointer to a PMECC_paramDesc instance.
- */
-static int substitute(struct _PMECC_paramDesc_struct *pPmeccDescriptor)
-{
-	int i, j;
-	short *si;
-	short *pPartialSyn = pPmeccDescriptor->partialSyn;
-	short *alpha_to = pPmeccDescriptor->alpha_to;
-	short *index_of = pPmeccDescriptor->index_of;
-
-	/*
-	 * si[] is a table that holds the current syndrome value,
-	 * an element of that table belongs to the field.
-	 */
-	si = pPmeccDescriptor->si;
-
-	for (i = 1; i < 2 * TT_MAX; i++)
-		si[i] = 0;
-
-	/* Computation 2t syndromes based on S(x) */
-	/* Odd syndromes */
-	for (i = 1; i <= 2 * pPmeccDescriptor->tt - 1; i = i + 2) {
-		si[i] = 0;
-		for (j = 0; j < pPmeccDescriptor->mm; j++) {
-			if (pPartialSyn[i] & ((unsigned short)0x1 << j))
-				si[i] = alpha_to[(i * j)] ^ si[i];
-		}
-	}
-	/* Even syndrome = (Odd syndrome) ** 2 */
-	for (i = 2; i <= 2 * pPmeccDescriptor->tt; i = i + 2) {
-		j = i / 2;
-		if (si[j] == 0)
-			si[i] = 0;
-		else
-			si[i] = alpha_to[mod((2 * index_of[si[j]]),
-				(unsigned int)pPmeccDescriptor->nn)];
-	}
-
-	return 0;
-}
-
-/*
- * \brief The substitute function finding the value of the error
- * location polynomial.
- * \param pPmeccDescriptor Pointer to a PMECC_paramDesc instance.
- */
-static unsigned int get_sigma(struct _PMECC_paramDesc_struct *pPmeccDescriptor)
-{
-	unsigned int dmu_0_count;
-	int i, j, k;
-	short *lmu = pPmeccDescriptor->lmu;
-	short *si = pPmeccDescriptor->si;
-	short tt = pPmeccDescriptor->tt;
-
-	/* mu  */
-	int mu[TT_MAX+1];
-
-	/* discrepancy */
-	int dmu[TT_MAX+1];
-
-	/* delta order   */
-	int delta[TT_MAX+1];
-
-	/* index of largest delta */
-	int ro;
-	int largest;
-	int diff;
-
-	dmu_0_count = 0;
-
-	/* First Row  */
-
-	/* Mu */
-	mu[0]  = -1;
-	/* Actually -1/2 */
-	/* Sigma(x) set to 1 */
-
-	for (i = 0; i < (2 * TT_MAX + 1); i++)
-		pPmeccDescriptor->smu[0][i] = 0;
-
-	pPmeccDescriptor->smu[0][0] = 1;
-
-	/* discrepancy set to 1 */
-	dmu[0] = 1;
-
-	/* polynom order set to 0 */
-	lmu[0] = 0;
-
-	/* delta set to -1 */
-	delta[0]  = (mu[0] * 2 - lmu[0]) >> 1;
-
-	/*                     */
-	/*     Second Row      */
-	/*                     */
-
-	/* Mu */
-	mu[1]  = 0;
-
-	/* Sigma(x) set to 1 */
-	for (i = 0; i < (2 * TT_MAX + 1); i++)
-		pPmeccDescriptor->smu[1][i] = 0;
-
-	pPmeccDescriptor->smu[1][0] = 1;
-
-	/* discrepancy set to S1 */
-	dmu[1] = si[1];
-
-	/* polynom order set to 0 */
-	lmu[1] = 0;
-
-	/* delta set to 0 */
-	delta[1]  = (mu[1] * 2 - lmu[1]) >> 1;
-
-	/* Init the Sigma(x) last row */
-	for (i = 0; i < (2 * TT_MAX + 1); i++)
-		pPmeccDescriptor->smu[tt + 1][i] = 0;
-
-	for (i = 1; i <= tt; i++) {
-		mu[i+1] = i << 1;
-		/* Compute Sigma (Mu+1)             */
-		/* And L(mu)                        */
-		/* check if discrepancy is set to 0 */
-		if (dmu[i] == 0) {
-			dmu_0_count++;
-			if ((tt - (lmu[i] >> 1) - 1) & 0x1) {
-				if (dmu_0_count
-					== ((tt - (lmu[i] >> 1) - 1) / 2) + 2) {
-					for (j = 0; j <= (lmu[i] >> 1) + 1; j++)
-						pPmeccDescriptor->smu[tt+1][j]
-						= pPmeccDescriptor->smu[i][j];
-
-					lmu[tt + 1] = lmu[i];
-					return 0;
-				}
-			} else {
-				if (dmu_0_count
-					== ((tt - (lmu[i] >> 1) - 1) / 2) + 1) {
-					for (j = 0; j <= (lmu[i] >> 1) + 1; j++)
-						pPmeccDescriptor->smu[tt + 1][j]
-						= pPmeccDescriptor->smu[i][j];
-
-					lmu[tt + 1] = lmu[i];
-					return 0;
-				}
-			}
-
-			/* copy polynom */
-			for (j = 0; j <= lmu[i] >> 1; j++)
-				pPmeccDescriptor->smu[i + 1][j]
-						= pPmeccDescriptor->smu[i][j];
-
-			/* copy previous polynom order to the next */
-			lmu[i + 1] = lmu[i];
-		} else {
-			ro = 0;
-			largest = -1;
-			/* find largest delta with dmu != 0 */
-			for (j = 0; j < i; j++) {
-				if (dmu[j]) {
-					if (delta[j] > largest) {
-						largest = delta[j];
-						ro = j;
-					}
-				}
-			}
-
-			/* compute difference */
-			diff = (mu[i] - mu[ro]);
-
-			/* Compute degree of the new smu polynomial */
-			if ((lmu[i]>>1) > ((lmu[ro]>>1) + diff))
-				lmu[i + 1] = lmu[i];
-			else
-				lmu[i + 1] = ((lmu[ro]>>1) + diff) * 2;
-
-			/* Init smu[i+1] with 0 */
-			for (k = 0; k < (2 * TT_MAX+1); k++)
-				pPmeccDescriptor->smu[i+1][k] = 0;
-
-			/* Compute smu[i+1] */
-			for (k = 0; k <= lmu[ro]>>1; k++)
-				if (pPmeccDescriptor->smu[ro][k] && dmu[i])
-					pPmeccDescriptor->smu[i + 1][k + diff] = pPmeccDescriptor->alpha_to[mod((pPmeccDescriptor->index_of[dmu[i]]
-						+ (pPmeccDescriptor->nn	- pPmeccDescriptor->index_of[dmu[ro]])
-						+ pPmeccDescriptor->index_of[pPmeccDescriptor->smu[ro][k]]), (unsigned int)pPmeccDescriptor->nn)];
-
-			for (k = 0; k <= lmu[i]>>1; k++)
-				pPmeccDescriptor->smu[i+1][k] ^= pPmeccDescriptor->smu[i][k];
-		}
-
-		/*************************************************/
-		/*                                               */
-		/*      End Compute Sigma (Mu+1)                 */
-		/*      And L(mu)                                */
-		/*************************************************/
-		/* In either case compute delta */
-		delta[i + 1]  = (mu[i + 1] * 2 - lmu[i + 1]) >> 1;
-
-		/* Do not compute discrepancy for the last iteration */
-		if (i < tt) {
-			for (k = 0 ; k <= (lmu[i + 1] >> 1); k++) {
-				if (k == 0)
-					dmu[i + 1] = si[2 * (i - 1) + 3];
-				/*
-				 * check if one operand of the multiplier
-				 * is null, its index is -1
-				 */
-				else if (pPmeccDescriptor->smu[i+1][k] && si[2 * (i - 1) + 3 - k])
-					dmu[i + 1] = pPmeccDescriptor->alpha_to[mod((pPmeccDescriptor->index_of[pPmeccDescriptor->smu[i + 1][k]]
-							+ pPmeccDescriptor->index_of[si[2 * (i - 1) + 3 - k]]), (unsigned int)pPmeccDescriptor->nn)] ^ dmu[i + 1];
-			}
-		}
-	}
-	return 0;
-}
-
 /*
  * \brief Init the PMECC Error Location peripheral and start the error
  *        location processing
@@ -1113,7 +1206,7 @@ static unsigned int ErrorCorrection(unsigned long pPMERRLOC,
 		if (bytePos < sectorSize) {
 			/* If error is located in the data area(not in ECC) */
 			errByte = (unsigned char *)(sectorBaseAddress + bytePos);
-			dbg_log(1, "Correct error bit @[#Byte %u,Bit# %u] " \
+			dbg_log(DEBUG_LOUD, "Correct error bit @[#Byte %u,Bit# %u] " \
 				"%u -> %u\n\r",
 				(unsigned int)bytePos,
 				(unsigned int)bitPos,
@@ -1124,7 +1217,7 @@ static unsigned int ErrorCorrection(unsigned long pPMERRLOC,
 			/* error is located in oob area */
 			errByte = (unsigned char *)(eccBaseAddress
 					+ (bytePos - sectorSize));
-			dbg_log(1, "Correct error bit in OOB @[#Byte %u,Bit# %u]" \
+			dbg_log(DEBUG_LOUD, "Correct error bit in OOB @[#Byte %u,Bit# %u]" \
 				" %u -> %u\n\r",
 				(unsigned int)bytePos - sectorSize,
 				(unsigned int)bitPos,
@@ -1141,30 +1234,31 @@ static unsigned int ErrorCorrection(unsigned long pPMERRLOC,
 
 /**
  * \brief Launch error detection functions and correct corrupted bits.
+ * \param pRemainders Address of the PMECC remainders (or of a copy).
  * \param pPmeccDescriptor Pointer to a PMECC_paramDesc instance.
  * \param pmeccStatus Value of the PMECC status register.
  * \param pageBuffer Base address of the buffer
  * 	containing the page to be corrected.
- * \param ErrorNbr Number of error to correct
+ * \param oobBuffer Base address of the buffer containing its spare area.
  * \return 0 if all errors have been corrected, 1 if too many errors detected
  */
-unsigned int PMECC_CorrectionAlgo(unsigned long pPMECC,
+unsigned int PMECC_CorrectionAlgo(unsigned long pRemainders,
 		unsigned long pPMERRLOC,
 		struct _PMECC_paramDesc_struct *pPmeccDescriptor,
 		unsigned int pmeccStatus,
-		void *pageBuffer)
+		void *pageBuffer,
+		void *oobBuffer)
 {
 	unsigned int sectorNumber = 0;
 	unsigned int sectorBaseAddress, eccBaseAddr;
 	volatile int errorNbr;
-	unsigned int sector_num_per_page, page_size_byte, ecc_byte_per_sector;
+	unsigned int sector_num_per_page, ecc_byte_per_sector;
 
 	/* Set the sector size (512 or 1024 bytes) */
 	pmecclor_writel((pPmeccDescriptor->sectorSize >> 4), PMERRLOC_ELCFG);
 
 	sector_num_per_page = div(pPmeccDescriptor->eccSizeByte,
 					get_pmecc_bytes());
-	page_size_byte = sector_num_per_page * PMECC_SECTOR_SIZE;
 	ecc_byte_per_sector = get_pmecc_bytes();
 
 	while (sectorNumber < sector_num_per_page) {
@@ -1174,16 +1268,15 @@ unsigned int PMECC_CorrectionAlgo(unsigned long pPMECC,
 
 			sectorBaseAddress = (unsigned int)pageBuffer
 					+ (sectorNumber * PMECC_SECTOR_SIZE);
-			eccBaseAddr = (unsigned int)pageBuffer
-					+ page_size_byte
+			eccBaseAddr = (unsigned int)oobBuffer
 					+ pmecc_readl(PMECC_SADDR)
 					+ (sectorNumber * ecc_byte_per_sector);
 
-			GenSyn(pPMECC, pPmeccDescriptor, sectorNumber);
+			GenSyn(pRemainders, pPmeccDescriptor, sectorNumber);
 
-			substitute(pPmeccDescriptor);
+			pmecc_substitute(pPmeccDescriptor);
 
-			get_sigma(pPmeccDescriptor);
+			pmecc_get_sigma(pPmeccDescriptor);
 			errorNbr = ErrorLocation(pPMERRLOC,
 					pPmeccDescriptor,
 					(((pPmeccDescriptor->sectorSize >> 4) + 1) * 512 * 8)
@@ -1192,13 +1285,15 @@ unsigned int PMECC_CorrectionAlgo(unsigned long pPMECC,
 
 			if (errorNbr == -1)
 				return 1;	/* uncorrectable errors */
-			else
-				ErrorCorrection(pPMERRLOC,
-						pPmeccDescriptor,
-						sectorBaseAddress,
-						eccBaseAddr,
-						ecc_byte_per_sector,
-						errorNbr);
+
+			ErrorCorrection(pPMERRLOC,
+					pPmeccDescriptor,
+					sectorBaseAddress,
+					eccBaseAddr,
+					ecc_byte_per_sector,
+					errorNbr);
+
+			nand_stats_bits(errorNbr);
 		}
 		sectorNumber++;
 		pmeccStatus = pmeccStatus >> 1;
@@ -1226,19 +1321,21 @@ void page_dump(unsigned char *buf, int page_size, int oob_size)
 	dbg_log(DEBUG_LOUD, "\r\n");
 }
 
-static int pmecc_process(struct nand_info *nand, unsigned char *buffer)
+/*
+ * Correct a page from the PMECC error status and remainders, which are
+ * either the registers or a copy of them taken by pmecc_save().
+ */
+static int pmecc_correct(struct nand_info *nand,
+			unsigned char *buffer,
+			unsigned char *oob,
+			unsigned int erris,
+			unsigned long remainders)
 {
 	int ret = 0;
 	int result;
-	unsigned int erris;
-
-	/* waiting for PMECC ready */
-	while (pmecc_readl(PMECC_SR) & AT91C_PMECC_BUSY);
 
-	/* read corrupted bit status */
-	erris = pmecc_readl(PMECC_ISR);
 	if (erris) {
-		if (check_pmecc_ecc_data(nand, buffer) == -1){
+		if (check_pmecc_ecc_data(nand, oob) == -1){
 			return 0;
 		}
 
@@ -1251,11 +1348,12 @@ static int pmecc_process(struct nand_info *nand, unsigned char *buffer)
 		 */
 		dbg_log(1, "PMECC: sector bits = %d, bit 1 means " \
 			"corrupted sector, Now correcting...\n\r", erris);
-		result = PMECC_CorrectionAlgo(AT91C_BASE_PMECC,
+		result = PMECC_CorrectionAlgo(remainders,
 					AT91C_BASE_PMERRLOC,
 					&PMECC_paramDesc,
 					erris,
-					buffer);
+					buffer,
+					oob);
 
 		if (result != 0) {
 			dbg_log(1, "PMECC: failed to " \
@@ -1269,6 +1367,46 @@ static int pmecc_process(struct nand_info *nand, unsigned char *buffer)
 
 	return ret;
 }
+
+static int pmecc_process(struct nand_info *nand, unsigned char *buffer)
+{
+	unsigned int erris;
+
+	/* waiting for PMECC ready */
+	while (pmecc_readl(PMECC_SR) & AT91C_PMECC_BUSY);
+
+	/* read corrupted bit status */
+	erris = pmecc_readl(PMECC_ISR);
+
+	return pmecc_correct(nand, buffer, buffer + nand->pagesize, erris,
+				AT91C_BASE_PMECC + PMECC_REM);
+}
+
+#ifdef CONFIG_NANDFLASH_DMA
+/* The PMECC result of a page, kept while the next page is read */
+struct pmecc_result {
+	unsigned int	erris;
+	unsigned int	rem[PMECC_MAX_SECTORS][PMECC_REM_SIZE / 4];
+};
+
+static void pmecc_save(struct pmecc_result *result)
+{
+	unsigned int sector, i;
+
+	while (pmecc_readl(PMECC_SR) & AT91C_PMECC_BUSY);
+
+	result->erris = pmecc_readl(PMECC_ISR);
+
+	for (sector = 0; sector < PMECC_MAX_SECTORS; sector++) {
+		if (!(result->erris & (1 << sector)))
+			continue;
+
+		for (i = 0; i < (PMECC_REM_SIZE / 4); i++)
+			result->rem[sector][i] = pmecc_readl(PMECC_REM
+					+ (sector * PMECC_REM_SIZE) + (i * 4));
+	}
+}
+#endif
 #endif /* #ifdef CONFIG_USE_PMECC */
 
 static int nand_read_status(void)
@@ -1394,27 +1532,286 @@ static int nand_read_sector(struct nand_info *nand,
 }
 
 #else /* large blocks */
-static int nand_read_sector(struct nand_info *nand,
-				unsigned int row_address,
-				unsigned char *buffer, 
-				unsigned int zone_flag)
+#ifdef CONFIG_USE_PMECC
+static void nand_pmecc_start(void)
 {
-	unsigned int readbytes, i;
+	pmecc_writel(AT91C_PMECC_RST, PMECC_CTRL);
+	pmecc_writel((pmecc_readl(PMECC_CFG) | AT91C_PMECC_AUTO_ENA),
+			PMECC_CFG);
+	pmecc_writel(AT91C_PMECC_ENABLE, PMECC_CTRL);
+}
+
+/* Restart the PMECC for the next page data */
+static void nand_pmecc_data(void)
+{
+	pmecc_writel(AT91C_PMECC_RST, PMECC_CTRL);
+	pmecc_writel(AT91C_PMECC_ENABLE | AT91C_PMECC_DATA, PMECC_CTRL);
+}
+#endif
+
+/*
+ * Send READ for a page: the chip then goes busy for tR, while it loads
+ * the page from the array into its cache register.
+ */
+static void nand_issue_read(struct nand_info *nand,
+				unsigned int row_address,
+				unsigned int column_address)
+{
+	if (nand->buswidth)
+		nand_command16(CMD_READ_1);
+	else
+		nand_command(CMD_READ_1);
+
+	write_column_address(nand, column_address);
+	write_row_address(nand, row_address);
+
+	if (nand->buswidth)
+		nand_command16(CMD_READ_2);
+	else
+		nand_command(CMD_READ_2);
+}
+
+/*
+ * Read a buffer from the data register. The SMC splits a 32-bit access
+ * into consecutive accesses of the device bus width, so a word aligned
+ * buffer is read by words, four at a time, instead of by bytes or half
+ * words.
+ */
+static void nand_read_buf(struct nand_info *nand,
+				unsigned char *pbuf,
+				unsigned int len)
+{
+	unsigned long ioaddr = (unsigned long)CONFIG_SYS_NAND_BASE;
+	unsigned int *pword;
+	unsigned int i;
+
+	if (((unsigned int)pbuf & 0x03) == 0) {
+		pword = (unsigned int *)pbuf;
+
+		for (i = len >> 4; i > 0; i--) {
+			pword[0] = readl(ioaddr);
+			pword[1] = readl(ioaddr);
+			pword[2] = readl(ioaddr);
+			pword[3] = readl(ioaddr);
+			pword += 4;
+		}
+
+		for (i = (len >> 2) & 0x03; i > 0; i--)
+			*pword++ = readl(ioaddr);
+
+		pbuf = (unsigned char *)pword;
+		len &= 0x03;
+	}
+
+	if (nand->buswidth) {
+		for (i = 0; i < len / 2; i++) {
+			*((short *)pbuf) = read_word();
+			pbuf += 2;
+		}
+	} else {
+		for (i = 0; i < len; i++)
+			*pbuf++ = read_byte();
+	}
+}
+
+/*
+ * Switch the chip back to data output after nand_read_status(), and
+ * restart the PMECC for the page data.
+ */
+static void nand_data_output(struct nand_info *nand, unsigned int usepmecc)
+{
+	if (nand->buswidth)
+		nand_command16(CMD_READ_1);
+	else
+		nand_command(CMD_READ_1);
+
+#ifdef CONFIG_USE_PMECC
+	if (usepmecc == 1)
+		nand_pmecc_data();
+#endif
+}
+
+/*
+ * Transfer readbytes of the page loaded by nand_issue_read(),
+ * once nand_read_status() has reported the chip ready.
+ */
+static void nand_read_data(struct nand_info *nand,
+				unsigned char *pbuf,
+				unsigned int readbytes,
+				unsigned int usepmecc)
+{
+	nand_data_output(nand, usepmecc);
+	nand_read_buf(nand, pbuf, readbytes);
+}
+
+/*
+ * READ CACHE SEQUENTIAL moves the loaded page to the cache register and
+ * starts loading the next one from the array, READ CACHE END only moves
+ * the last page.
+ */
+static void nand_read_cache(struct nand_info *nand, unsigned char command)
+{
+	if (nand->buswidth)
+		nand_command16(command);
+	else
+		nand_command(command);
+}
+
+#ifdef CONFIG_NANDFLASH_NFC
+#define NFC_TIMEOUT		0x100000
+
+#define AT91C_NFC_ERRORS	(AT91C_NFC_DTOE | AT91C_NFC_UNDEF \
+				| AT91C_NFC_AWB | AT91C_NFC_NFCASE)
+
+static unsigned int nfc_enabled;
+
+static unsigned int nfc_readl(unsigned int reg)
+{
+	return readl(AT91C_BASE_NFC + reg);
+}
+
+static void nfc_writel(unsigned int value, unsigned int reg)
+{
+	writel(value, AT91C_BASE_NFC + reg);
+}
+
+static int nfc_init(struct nand_info *nand)
+{
+	unsigned int pagesize = AT91C_NFC_PAGESIZE_512;
+	unsigned int size;
+
+	for (size = 512; size < nand->pagesize; size <<= 1)
+		pagesize++;
+
+	if ((size != nand->pagesize) || (pagesize > AT91C_NFC_PAGESIZE_8192)
+		|| (nand->oobsize & 0x03)) {
+		dbg_log(1, "NFC: Not supported page size: %d\n\r",
+							nand->pagesize);
+		return -1;
+	}
+
+	/* The spare area is read in the SRAM, after the page data */
+	nfc_writel(pagesize
+		| AT91C_NFC_SPARESIZE(nand->oobsize)
+		| AT91C_NFC_RSPARE
+		| AT91C_NFC_DTOCYC
+		| AT91C_NFC_DTOMUL, NFC_CFG);
+
+	nfc_writel(AT91C_NFC_ENABLE, NFC_CTRL);
+
+	nfc_enabled = 1;
+	dbg_log(1, "NAND: Read pages with the NFC\n\r");
+
+	return 0;
+}
+
+/*
+ * Let the NFC send READ for a page, with the same address cycles as
+ * write_column_address() and write_row_address(), wait for the chip and
+ * transfer the page and its spare area to the bank 0 of its SRAM.
+ */
+static int nfc_read_page(struct nand_info *nand, unsigned int row_address)
+{
+	unsigned char cycles[8];
+	unsigned int ncycles = 0;
+	unsigned int cycle0 = 0;
+	unsigned int addr1234 = 0;
+	unsigned int timeout = NFC_TIMEOUT;
+	unsigned int status = 0;
+	unsigned int size;
+	unsigned int i, shift;
+
+	for (size = nand->pagesize; size > 2; size >>= 8)
+		cycles[ncycles++] = 0;
+
+	for (size = nand->pages_device; size; size >>= 8) {
+		cycles[ncycles++] = row_address & 0xff;
+		row_address >>= 8;
+	}
+
+	/* Beyond 4 cycles, the first one goes to the NFC_ADDR register */
+	i = 0;
+	if (ncycles > 4)
+		cycle0 = cycles[i++];
+
+	for (shift = 0; i < ncycles; i++, shift += 8)
+		addr1234 |= cycles[i] << shift;
+
+	while ((readl(AT91C_BASE_NFC_CMD + AT91C_NFC_NFCBUSY)
+			& AT91C_NFC_NFCBUSY) && --timeout)
+		;
+
+	/* Clear the status */
+	nfc_readl(NFC_SR);
+
+	nfc_writel(cycle0, NFC_ADDR);
+	writel(addr1234, AT91C_BASE_NFC_CMD
+			+ (AT91C_NFC_CMD1(CMD_READ_1)
+			| AT91C_NFC_CMD2(CMD_READ_2)
+			| AT91C_NFC_VCMD2
+			| AT91C_NFC_ACYCLE(ncycles)
+			| AT91C_NFC_CSID(CONFIG_SYS_NAND_NFC_CS)
+			| AT91C_NFC_DATAEN
+			| AT91C_NFC_NFCRD));
+
+	timeout = NFC_TIMEOUT;
+	do {
+		status |= nfc_readl(NFC_SR);
+		if (status & AT91C_NFC_ERRORS) {
+			dbg_log(1, "NFC: Read error, status: %d\n\r", status);
+			return -1;
+		}
+	} while (!(status & AT91C_NFC_XFRDONE) && --timeout);
+
+	if (!timeout) {
+		dbg_log(1, "NFC: Read timeout\n\r");
+		return -1;
+	}
+
+	return 0;
+}
+
+/*
+ * Read the data zone of a page, as nand_read_sector() does, the PMECC
+ * being fed by the NFC transfer.
+ */
+static int nfc_read_sector(struct nand_info *nand,
+				unsigned int row_address,
+				unsigned char *buffer,
+				unsigned int readbytes,
+				unsigned int usepmecc)
+{
+#ifdef CONFIG_USE_PMECC
+	if (usepmecc == 1)
+		nand_pmecc_data();
+#endif
+
+	if (nfc_read_page(nand, row_address))
+		return -1;
+
+	memcpy(buffer, (void *)AT91C_BASE_NFC_SRAM, readbytes);
+
+	return 0;
+}
+#endif /* #ifdef CONFIG_NANDFLASH_NFC */
+
+static int nand_read_sector(struct nand_info *nand,
+				unsigned int row_address,
+				unsigned char *buffer, 
+				unsigned int zone_flag)
+{
+	unsigned int readbytes;
 	unsigned int column_address;
+	unsigned int usepmecc = 0;
 	int ret = 0;
 	unsigned char *pbuf = buffer;
 
 #ifdef CONFIG_USE_PMECC
-	unsigned int usepmecc = 0;
-
 	if ((zone_flag & ZONE_DATA) == ZONE_DATA) {
 		usepmecc = 1;
 		zone_flag = ZONE_DATA | ZONE_INFO;
 
-		pmecc_writel(AT91C_PMECC_RST, PMECC_CTRL);
-		pmecc_writel((pmecc_readl(PMECC_CFG) | AT91C_PMECC_AUTO_ENA),
-				PMECC_CFG);
-		pmecc_writel(AT91C_PMECC_ENABLE, PMECC_CTRL);
+		nand_pmecc_start();
 	}
 #endif	/* #ifdef CONFIG_USE_PMECC */
 
@@ -1439,50 +1836,34 @@ static int nand_read_sector(struct nand_info *nand,
 		return -1;
 	}
 
-	nand_cs_enable();
-
-	if (nand->buswidth)
-		nand_command16(CMD_READ_1);
-	else
-		nand_command(CMD_READ_1);
+#ifdef CONFIG_NANDFLASH_NFC
+	/* The spare area alone is shorter to read directly */
+	if (nfc_enabled && (zone_flag & ZONE_DATA)) {
+		ret = nfc_read_sector(nand, row_address, buffer,
+					readbytes, usepmecc);
+#ifdef CONFIG_USE_PMECC
+		if (!ret && (usepmecc == 1) && !nand->buswidth)
+			ret = pmecc_process(nand, buffer);
+#endif
+		return ret;
+	}
+#endif
 
-	write_column_address(nand, column_address);
-	write_row_address(nand, row_address);
+	nand_cs_enable();
 
-	if (nand->buswidth)
-		nand_command16(CMD_READ_2);
-	else
-		nand_command(CMD_READ_2);
+	nand_issue_read(nand, row_address, column_address);
 
-	if (nand_read_status())
+	if (nand_read_status()) {
+		nand_cs_disable();
 		return -1;
-
-	if (nand->buswidth)
-		nand_command16(CMD_READ_1);
-	else
-		nand_command(CMD_READ_1);
-
-#ifdef CONFIG_USE_PMECC
-	if (usepmecc == 1) {
-		pmecc_writel(AT91C_PMECC_RST, PMECC_CTRL);
-		pmecc_writel(AT91C_PMECC_ENABLE | AT91C_PMECC_DATA, PMECC_CTRL);
 	}
-#endif
-	/* Read loop */
-	if (nand->buswidth) {
-		for (i = 0; i < readbytes / 2; i++) {
-			*((short *)pbuf) = read_word();
-			pbuf += 2;
-		}
-	} else {
-		for (i = 0; i < readbytes; i++)
-			*pbuf++ = read_byte();
+
+	nand_read_data(nand, pbuf, readbytes, usepmecc);
 
 #ifdef CONFIG_USE_PMECC
-		if (usepmecc == 1)
-			ret = pmecc_process(nand, buffer);
+	if ((usepmecc == 1) && !nand->buswidth)
+		ret = pmecc_process(nand, buffer);
 #endif
-	}
 
 	nand_cs_disable();
 
@@ -1490,27 +1871,6 @@ static int nand_read_sector(struct nand_info *nand,
 }
 #endif /* #ifdef NANDFLASH_SMALL_BLOCKS */
 
-static int nand_check_badblock(struct nand_info *nand,
-				unsigned int block,
-				unsigned char *buffer)
-{
-	unsigned int page;
-	unsigned int row_address = block * nand->pages_block;
-
-	/*
-	 * Read the first page and second page oob zone
-	 * to detect if block is bad
-	 */
-	for (page = 0; page < 2; page++) {
-		nand_read_sector(nand, row_address + page, buffer, ZONE_INFO);
-		if (*(buffer + nand->pagesize + nand->ecclayout->badblockpos)
-			!= 0xff)
-			return -1;
-	}
-
-	return 0;
-}
-
 #ifdef CONFIG_ENABLE_SW_ECC
 static void nand_read_ecc(struct nand_ooblayout *ooblayout,
 				unsigned char *buffer,
@@ -1521,6 +1881,29 @@ static void nand_read_ecc(struct nand_ooblayout *ooblayout,
 	for (i = 0; i < ooblayout->eccbytes; i++)
 		ecc[i] = buffer[ooblayout->eccpos[i]];
 }
+
+static int nand_hamming_verify(struct nand_info *nand, unsigned char *buffer)
+{
+	unsigned char hamming[48], error;
+	unsigned int i;
+
+	nand_read_ecc(nand->ecclayout, buffer + nand->pagesize, hamming);
+
+	/* By 256-byte sectors, to count the corrected ones */
+	for (i = 0; i < nand->pagesize; i += 256) {
+		error = Hamming_Verify256x(buffer + i, 256,
+					hamming + (i >> 8) * 3);
+		if (error && (error != Hamming_ERROR_SINGLEBIT)) {
+			dbg_log(1, "NAND: Hamming ECC error!\n\r");
+			return -1;
+		}
+
+		if (error == Hamming_ERROR_SINGLEBIT)
+			nand_stats_bits(1);
+	}
+
+	return 0;
+}
 #endif
 
 static int nand_read_page(struct nand_info *nand,
@@ -1531,28 +1914,159 @@ static int nand_read_page(struct nand_info *nand,
 {
 	unsigned int row_address = block * nand->pages_block + page;
 
+	nand_stats_set_block(block);
+
 #ifndef CONFIG_ENABLE_SW_ECC
 	return nand_read_sector(nand, row_address, buffer, ZONE_DATA);
 #else
 
 	int retval;
-	unsigned char hamming[48], error;
 
 	retval = nand_read_sector(nand, row_address, buffer,
 				ZONE_DATA | ZONE_INFO);
 	if (retval)
 		return -1;
 
-	nand_read_ecc(nand->ecclayout, buffer + nand->pagesize, hamming);
+	return nand_hamming_verify(nand, buffer);
+#endif /* #ifndef CONFIG_ENABLE_SW_ECC */
+}
+
+#ifdef CONFIG_NANDFLASH_BBT
+/*
+ * Linux flash based bad block table: the main and mirror tables are in
+ * the last blocks of the device, marked by the "Bbt0" and "1tbB"
+ * patterns in the OOB of their first page, followed by a version byte.
+ * The table starts at page 0 of the block and holds 2 bits per block,
+ * from the LSB of each byte: 0x3 means good, anything else is either
+ * bad or reserved for the table itself.
+ */
+#define NAND_BBT_SEARCH_BLOCKS		4
+#define NAND_BBT_PATTERN_OFFSET		8
+#define NAND_BBT_VERSION_OFFSET		12
+#define NAND_BBT_MAX_BLOCKS		8192
+
+/* One bit per block, set if the block must be skipped */
+static unsigned char nand_bbt[NAND_BBT_MAX_BLOCKS / 8];
+static unsigned int nand_bbt_valid;
+
+static int nand_bbt_find(struct nand_info *nand,
+			unsigned char *buffer,
+			const char *pattern,
+			unsigned char *version)
+{
+	unsigned char *oob = buffer + nand->pagesize;
+	unsigned int block;
+	unsigned int i;
+
+	for (i = 0; (i < NAND_BBT_SEARCH_BLOCKS) && (i < nand->numblocks);
+									i++) {
+		block = nand->numblocks - 1 - i;
+
+		if (nand_read_sector(nand, block * nand->pages_block,
+						buffer, ZONE_INFO))
+			continue;
+
+		if (!memcmp(oob + NAND_BBT_PATTERN_OFFSET, pattern, 4)) {
+			*version = oob[NAND_BBT_VERSION_OFFSET];
+			return block;
+		}
+	}
+
+	return -1;
+}
+
+static int nand_bbt_read(struct nand_info *nand,
+			unsigned int bbt_block,
+			unsigned char *buffer)
+{
+	unsigned int size = (nand->numblocks + 3) >> 2;
+	unsigned int page;
+	unsigned int block;
+	unsigned int code;
+
+	for (page = 0; (page * nand->pagesize) < size; page++) {
+		if (nand_read_page(nand, bbt_block, page, ZONE_DATA,
+					buffer + page * nand->pagesize))
+			return -1;
+	}
+
+	memset(nand_bbt, 0, sizeof(nand_bbt));
+
+	for (block = 0; block < nand->numblocks; block++) {
+		code = (buffer[block >> 2] >> ((block & 0x03) << 1)) & 0x03;
+		if (code != 0x03)
+			nand_bbt[block >> 3] |= 1 << (block & 0x07);
+	}
+
+	return 0;
+}
+
+/*
+ * Use the most recent of the main and mirror tables, or the other one
+ * if it can't be read. The buffer must hold the table pages.
+ */
+static int nand_bbt_scan(struct nand_info *nand, unsigned char *buffer)
+{
+	int main_block, mirror_block;
+	unsigned char main_version = 0, mirror_version = 0;
+	int block;
+
+	nand_bbt_valid = 0;
+
+	if (nand->numblocks > NAND_BBT_MAX_BLOCKS)
+		return -1;
+
+	main_block = nand_bbt_find(nand, buffer, "Bbt0", &main_version);
+	mirror_block = nand_bbt_find(nand, buffer, "1tbB", &mirror_version);
+
+	if ((main_block < 0)
+		|| ((mirror_block >= 0) && (mirror_version > main_version))) {
+		block = main_block;
+		main_block = mirror_block;
+		mirror_block = block;
+	}
+
+	if ((main_block >= 0) && !nand_bbt_read(nand, main_block, buffer))
+		block = main_block;
+	else if ((mirror_block >= 0)
+			&& !nand_bbt_read(nand, mirror_block, buffer))
+		block = mirror_block;
+	else {
+		dbg_log(1, "NAND: No bad block table found\n\r");
+		return -1;
+	}
+
+	dbg_log(1, "NAND: Bad block table found at block: %d\n\r", block);
+	nand_bbt_valid = 1;
+
+	return 0;
+}
+#endif /* #ifdef CONFIG_NANDFLASH_BBT */
+
+static int nand_check_badblock(struct nand_info *nand,
+				unsigned int block,
+				unsigned char *buffer)
+{
+	unsigned int page;
+	unsigned int row_address = block * nand->pages_block;
 
-	error = Hamming_Verify256x(buffer, nand->pagesize, hamming);
-	if (error && (error != Hamming_ERROR_SINGLEBIT)) {
-		dbg_log(1, "NAND: Hamming ECC error!\n\r");
-		return -1;
+#ifdef CONFIG_NANDFLASH_BBT
+	if (nand_bbt_valid)
+		return (nand_bbt[block >> 3] & (1 << (block & 0x07))) ? -1 : 0;
+#endif
+
+	/*
+	 * Read the first page and second page oob zone
+	 * to detect if block is bad
+	 */
+	for (page = 0; page < 2; page++) {
+		nand_read_sector(nand, row_address + page, buffer, ZONE_INFO);
+		if (*(buffer + nand->pagesize + nand->ecclayout->badblockpos)
+			!= 0xff)
+			return -1;
 	}
 
 	return 0;
-#endif /* #ifndef CONFIG_ENABLE_SW_ECC */
 }
 
 #ifdef CONFIG_NANDFLASH_RECOVERY
@@ -1612,6 +2126,421 @@ static int nandflash_recovery(struct nand_info *nand)
 }
 #endif /* #ifdef CONFIG_NANDFLASH_RECOVERY */
 
+#ifdef CONFIG_BOOTSTAGE
+/*
+ * Page read timing, in PIT ticks (MCK/16): waiting for the array load,
+ * transferring the page and correcting it. As the next page is loaded
+ * while the current one is corrected, the wait drops to the part of tR
+ * which is not covered by the ECC work.
+ */
+struct nand_read_timing {
+	unsigned int	pages;
+	unsigned int	wait;
+	unsigned int	transfer;
+	unsigned int	ecc;
+};
+
+static struct nand_read_timing nand_timing;
+
+static inline unsigned long long nand_ticks(void)
+{
+	return timer_get_ticks();
+}
+
+static void nand_timing_update(unsigned int page,
+				unsigned long long *ticks)
+{
+	unsigned int wait = (unsigned int)(ticks[1] - ticks[0]);
+	unsigned int transfer = (unsigned int)(ticks[2] - ticks[1]);
+	unsigned int ecc = (unsigned int)(ticks[3] - ticks[2]);
+
+	dbg_log(DEBUG_LOUD, "NAND: page %d: wait: %d, transfer: %d, " \
+		"ecc: %d\n\r", page, wait, transfer, ecc);
+
+	nand_timing.pages++;
+	nand_timing.wait += wait;
+	nand_timing.transfer += transfer;
+	nand_timing.ecc += ecc;
+}
+
+static void nand_timing_report(void)
+{
+	dbg_log(1, "NAND: %d pages read, ticks: wait: %d, transfer: %d, " \
+		"ecc: %d\n\r", nand_timing.pages, nand_timing.wait,
+		nand_timing.transfer, nand_timing.ecc);
+
+	memset(&nand_timing, 0, sizeof(nand_timing));
+}
+#else
+static inline unsigned long long nand_ticks(void)
+{
+	return 0;
+}
+
+static inline void nand_timing_update(unsigned int page,
+				unsigned long long *ticks)
+{
+}
+
+static inline void nand_timing_report(void)
+{
+}
+#endif /* #ifdef CONFIG_BOOTSTAGE */
+
+#ifndef NANDFLASH_SMALL_BLOCKS
+static int nand_correct_page(struct nand_info *nand, unsigned char *buffer)
+{
+#if defined(CONFIG_USE_PMECC)
+	if (!nand->buswidth)
+		return pmecc_process(nand, buffer);
+#elif defined(CONFIG_ENABLE_SW_ECC)
+	return nand_hamming_verify(nand, buffer);
+#endif
+	return 0;
+}
+
+#ifdef CONFIG_NANDFLASH_DMA
+#define NAND_DMA_CHANNEL	0
+#define NAND_DMA_OOB_SIZE	256
+#define NAND_DMA_ALIGN		32	/* cache line */
+
+/*
+ * Two sets of buffers: the page data goes straight to its destination,
+ * the spare area to an SRAM buffer, as the next page data would
+ * overwrite it while it is being corrected.
+ */
+static struct dmac_desc nand_dma_desc[2][2]
+			__attribute__((aligned(NAND_DMA_ALIGN)));
+static unsigned char nand_dma_oob[2][NAND_DMA_OOB_SIZE]
+			__attribute__((aligned(NAND_DMA_ALIGN)));
+static struct pmecc_result nand_dma_ecc[2];
+
+static int nand_dma_usable(struct nand_info *nand, unsigned char *buffer)
+{
+	return !nand->buswidth
+		&& (((unsigned int)buffer & (NAND_DMA_ALIGN - 1)) == 0)
+		&& ((nand->pagesize & (NAND_DMA_ALIGN - 1)) == 0)
+		&& ((nand->oobsize & 0x03) == 0)
+		&& (nand->oobsize <= NAND_DMA_OOB_SIZE);
+}
+
+static void nand_dma_invalidate(unsigned char *start, unsigned int len)
+{
+#ifdef CONFIG_MMU
+	dcache_invalidate_range((unsigned int)start, (unsigned int)start + len);
+#endif
+}
+
+static void nand_dma_set_desc(struct dmac_desc *desc,
+				unsigned char *dest,
+				unsigned int len,
+				struct dmac_desc *next)
+{
+	desc->saddr = (unsigned int)CONFIG_SYS_NAND_BASE;
+	desc->daddr = (unsigned int)dest;
+	desc->ctrla = (len >> 2)
+			| AT91C_DMAC_SRC_WIDTH_WORD
+			| AT91C_DMAC_DST_WIDTH_WORD;
+	desc->ctrlb = AT91C_DMAC_SIF(0)
+			| AT91C_DMAC_DIF(0)
+			| AT91C_DMAC_FC_MEM2MEM
+			| AT91C_DMAC_SRC_INCR_FIXED
+			| AT91C_DMAC_DST_INCR_INCREMENTING;
+	desc->dscr = (unsigned int)next;
+}
+
+/* Transfer a page data to buffer and its spare area to nand_dma_oob[set] */
+static void nand_dma_start(struct nand_info *nand,
+				unsigned char *buffer,
+				unsigned int set)
+{
+	nand_dma_set_desc(&nand_dma_desc[set][0], buffer, nand->pagesize,
+				&nand_dma_desc[set][1]);
+	nand_dma_set_desc(&nand_dma_desc[set][1], nand_dma_oob[set],
+				nand->oobsize, 0);
+
+	nand_dma_invalidate(buffer, nand->pagesize);
+	nand_dma_invalidate(nand_dma_oob[set], NAND_DMA_OOB_SIZE);
+
+	dmac_start(NAND_DMA_CHANNEL, nand_dma_desc[set],
+				AT91C_DMAC_FIFOCFG_HALF);
+}
+
+static int nand_dma_end(struct nand_info *nand,
+				unsigned char *buffer,
+				unsigned int set)
+{
+	if (dmac_wait(NAND_DMA_CHANNEL))
+		return -1;
+
+	/* Lines may have been fetched speculatively during the transfer */
+	nand_dma_invalidate(buffer, nand->pagesize);
+	nand_dma_invalidate(nand_dma_oob[set], NAND_DMA_OOB_SIZE);
+
+	/* Keep the remainders, the next page resets them */
+	pmecc_save(&nand_dma_ecc[set]);
+
+	return 0;
+}
+
+static int nand_dma_correct(struct nand_info *nand,
+				unsigned char *buffer,
+				unsigned int set)
+{
+	return pmecc_correct(nand, buffer, nand_dma_oob[set],
+				nand_dma_ecc[set].erris,
+				(unsigned long)nand_dma_ecc[set].rem);
+}
+
+/*
+ * Same sequence as nand_read_block(), with the pages transferred by the
+ * DMAC: the previous page is corrected while the current one is being
+ * transferred, so the PMECC work overlaps the bus transfer instead of
+ * following it.
+ * In the timing counters, the ECC time of a page is the one of the
+ * previous page, spent during its transfer.
+ */
+static int nand_read_block_dma(struct nand_info *nand,
+				unsigned int block,
+				unsigned int start_page,
+				unsigned int end_page,
+				unsigned char *buffer)
+{
+	unsigned int row_address = block * nand->pages_block + start_page;
+	unsigned char *prev_buffer = 0;
+	unsigned int set = 0;
+	unsigned int streaming;
+	unsigned int page;
+	unsigned long long ticks[4];
+	unsigned long long ecc_start;
+	int ret = 0;
+
+	nand_pmecc_start();
+
+	streaming = nand->read_cache && ((end_page - start_page) > 1);
+
+	nand_cs_enable();
+
+	nand_issue_read(nand, row_address, 0);
+	if (streaming)
+		ret = nand_read_status();
+
+	for (page = start_page; (page < end_page) && !ret; page++) {
+		ticks[0] = nand_ticks();
+
+		if (streaming)
+			nand_read_cache(nand, ((page + 1) < end_page) ?
+					CMD_READ_CACHE : CMD_READ_CACHE_END);
+
+		ret = nand_read_status();
+		if (ret)
+			break;
+
+		ticks[1] = nand_ticks();
+
+		nand_data_output(nand, 1);
+		nand_dma_start(nand, buffer, set);
+
+		ecc_start = nand_ticks();
+		if (prev_buffer)
+			ret = nand_dma_correct(nand, prev_buffer, set ^ 1);
+		ticks[3] = nand_ticks() - ecc_start;
+
+		if (nand_dma_end(nand, buffer, set))
+			ret = -1;
+		if (ret)
+			break;
+
+		ticks[2] = nand_ticks();
+		ticks[3] += ticks[2];
+		nand_timing_update(page, ticks);
+
+		if (!streaming && ((page + 1) < end_page))
+			nand_issue_read(nand, ++row_address, 0);
+
+		prev_buffer = buffer;
+		buffer += nand->pagesize;
+		set ^= 1;
+	}
+
+	nand_cs_disable();
+
+	if (!ret && prev_buffer)
+		ret = nand_dma_correct(nand, prev_buffer, set ^ 1);
+
+	return ret;
+}
+#endif /* #ifdef CONFIG_NANDFLASH_DMA */
+
+#ifdef CONFIG_NANDFLASH_NFC
+/*
+ * Read the pages [start_page, end_page) of a block through the NFC,
+ * which sends the commands and waits for the chip by itself.
+ */
+static int nand_read_block_nfc(struct nand_info *nand,
+				unsigned int block,
+				unsigned int start_page,
+				unsigned int end_page,
+				unsigned char *buffer)
+{
+	unsigned int row_address = block * nand->pages_block + start_page;
+	unsigned int readbytes = nand->pagesize;
+	unsigned int page;
+	unsigned long long ticks[4];
+	int ret = 0;
+
+#if defined(CONFIG_USE_PMECC) || defined(CONFIG_ENABLE_SW_ECC)
+	readbytes = nand->sectorsize;
+#endif
+#ifdef CONFIG_USE_PMECC
+	nand_pmecc_start();
+#endif
+
+	for (page = start_page; page < end_page; page++) {
+		ticks[0] = nand_ticks();
+
+#ifdef CONFIG_USE_PMECC
+		nand_pmecc_data();
+#endif
+		ret = nfc_read_page(nand, row_address++);
+		if (ret)
+			break;
+
+		ticks[1] = nand_ticks();
+
+		memcpy(buffer, (void *)AT91C_BASE_NFC_SRAM, readbytes);
+
+		ticks[2] = nand_ticks();
+
+		ret = nand_correct_page(nand, buffer);
+		if (ret)
+			break;
+
+		ticks[3] = nand_ticks();
+		nand_timing_update(page, ticks);
+
+		buffer += nand->pagesize;
+	}
+
+	return ret;
+}
+#endif /* #ifdef CONFIG_NANDFLASH_NFC */
+
+/*
+ * Read the pages [start_page, end_page) of a block. The READ of the
+ * next page is issued as soon as the current one is transferred, so the
+ * chip loads it (tR) while the current page is being corrected. The
+ * PMECC remainders are not affected by the command and address cycles,
+ * they are only reset when the next page data is read.
+ *
+ * If the chip supports it, the block is streamed with READ CACHE
+ * SEQUENTIAL instead: the next page is loaded from the array while the
+ * current one is transferred and corrected, so only the first page of
+ * the block pays the full tR.
+ */
+static int nand_read_block(struct nand_info *nand,
+				unsigned int block,
+				unsigned int start_page,
+				unsigned int end_page,
+				unsigned char *buffer)
+{
+	unsigned int row_address = block * nand->pages_block + start_page;
+	unsigned int readbytes = nand->pagesize;
+	unsigned int usepmecc = 0;
+	unsigned int streaming;
+	unsigned int page;
+	unsigned long long ticks[4];
+	int ret = 0;
+
+	nand_stats_set_block(block);
+
+#ifdef CONFIG_NANDFLASH_NFC
+	if (nfc_enabled)
+		return nand_read_block_nfc(nand, block, start_page, end_page,
+					buffer);
+#endif
+
+#ifdef CONFIG_NANDFLASH_DMA
+	if (nand_dma_usable(nand, buffer))
+		return nand_read_block_dma(nand, block, start_page, end_page,
+					buffer);
+#endif
+
+#if defined(CONFIG_USE_PMECC) || defined(CONFIG_ENABLE_SW_ECC)
+	readbytes = nand->sectorsize;
+#endif
+#ifdef CONFIG_USE_PMECC
+	usepmecc = 1;
+	nand_pmecc_start();
+#endif
+
+	streaming = nand->read_cache && ((end_page - start_page) > 1);
+
+	nand_cs_enable();
+
+	nand_issue_read(nand, row_address, 0);
+	if (streaming)
+		ret = nand_read_status();
+
+	for (page = start_page; (page < end_page) && !ret; page++) {
+		ticks[0] = nand_ticks();
+
+		if (streaming)
+			nand_read_cache(nand, ((page + 1) < end_page) ?
+					CMD_READ_CACHE : CMD_READ_CACHE_END);
+
+		ret = nand_read_status();
+		if (ret)
+			break;
+
+		ticks[1] = nand_ticks();
+
+		nand_read_data(nand, buffer, readbytes, usepmecc);
+
+		ticks[2] = nand_ticks();
+
+		if (!streaming && ((page + 1) < end_page))
+			nand_issue_read(nand, ++row_address, 0);
+
+		ret = nand_correct_page(nand, buffer);
+		if (ret)
+			break;
+
+		ticks[3] = nand_ticks();
+		nand_timing_update(page, ticks);
+
+		buffer += nand->pagesize;
+	}
+
+	nand_cs_disable();
+
+	return ret;
+}
+#endif /* #ifndef NANDFLASH_SMALL_BLOCKS */
+
+/* Times a block is read again after an uncorrectable page */
+#define NAND_READ_RETRIES	2
+
+#ifndef NANDFLASH_SMALL_BLOCKS
+/*
+ * RESET takes the chip back to timing mode 0: issue it with the board
+ * SMC timings, then switch to the fast mode again.
+ */
+static void nandflash_reset_chip(struct nand_info *nand)
+{
+#ifdef CONFIG_NANDFLASH_ONFI_TIMING
+	nandflash_hw_init();
+	nandflash_config_buswidth(nand->buswidth ? 1 : 0);
+#endif
+
+	nandflash_reset();
+
+#ifdef CONFIG_NANDFLASH_ONFI_TIMING
+	nand_init_timing_mode(&nand_chip_default);
+#endif
+}
+#endif
+
 static int nand_loadimage(struct nand_info *nand,
 				unsigned int offset,
 				unsigned int length,
@@ -1620,7 +2549,11 @@ static int nand_loadimage(struct nand_info *nand,
 	unsigned char *buffer = dest;
 	unsigned int readsize;
 	unsigned int block = 0;
+#ifdef NANDFLASH_SMALL_BLOCKS
 	unsigned int page;
+#else
+	unsigned int retry;
+#endif
 	unsigned int start_page = 0;
 	unsigned int end_page;
 	unsigned int numpages = 0;
@@ -1656,28 +2589,82 @@ static int nand_loadimage(struct nand_info *nand,
 		}
 
 		/* read pages of a block */
+#ifdef NANDFLASH_SMALL_BLOCKS
 		for (page = start_page; page < end_page; page++) {
 			ret = nand_read_page(nand, block, page,
 						ZONE_DATA, buffer);
 			if (ret)
 				return -1;
-			else
-				buffer += nand->pagesize;
+
+			nand_stats_commit();
+			buffer += nand->pagesize;
+		}
+#else
+		for (retry = 0; ; retry++) {
+			ret = nand_read_block(nand, block, start_page,
+						end_page, buffer);
+			if (!ret || (retry == NAND_READ_RETRIES))
+				break;
+
+			dbg_log(1, "NAND: Read error in block #%d, " \
+					"retrying\n\r", block);
+			nand_stats_retry();
+
+			/*
+			 * The failed attempt may have left the chip in the
+			 * middle of a sequence (READ CACHE without its 3Fh
+			 * end, a status timeout): start the retry afresh.
+			 */
+			nandflash_reset_chip(nand);
 		}
+		if (ret)
+			return -1;
+
+		nand_stats_commit();
+
+		buffer += numpages * nand->pagesize;
+#endif
 		length -= readsize;
 
 		block++;
 		start_page = 0;
 	}
 
+	nand_timing_report();
+
 	return 0;
 }
 
+#if defined(CONFIG_LOAD_LINUX) || defined(CONFIG_LOAD_ANDROID)
+/*
+ * Read the first page of the image and work out from its header how many
+ * bytes really have to be read, instead of the whole partition window.
+ */
+static int update_image_length(struct nand_info *nand,
+				unsigned int offset,
+				unsigned int length,
+				unsigned char *dest,
+				unsigned char flag)
+{
+	int ret;
+
+	ret = nand_loadimage(nand, offset, nand->pagesize, dest);
+	if (ret)
+		return -1;
+
+	return image_header_length(dest, length, flag);
+}
+#endif
+
 int load_nandflash(struct image_info *image)
 {
 	struct nand_info nand;
+#if defined(CONFIG_LOAD_LINUX) || defined(CONFIG_LOAD_ANDROID)
+	int length;
+#endif
 	int ret;
 
+	bootstage_mark("nand_init");
 	nandflash_hw_init();
 
 	if (nandflash_get_type(&nand))
@@ -1697,6 +2684,33 @@ int load_nandflash(struct image_info *image)
 	dbg_log(1, "NAND: Using Software ECC\n\r");
 #endif
 
+#ifdef CONFIG_NANDFLASH_DMA
+	dmac_init();
+#endif
+
+#ifdef CONFIG_NANDFLASH_NFC
+	nfc_init(&nand);
+#endif
+
+#ifdef CONFIG_NANDFLASH_BBT
+	/* The image destination is free to hold the table pages */
+	nand_bbt_scan(&nand, image->dest);
+#endif
+
+	bootstage_mark("nand_load_image");
+
+#if defined(CONFIG_LOAD_LINUX) || defined(CONFIG_LOAD_ANDROID)
+	length = update_image_length(&nand, image->offset,
+				image->length, image->dest, KERNEL_IMAGE);
+	if (length < 0)
+		return -1;
+
+	image->length = length;
+	image->dest = kernel_image_dest(image,
+			div(length + nand.pagesize - 1, nand.pagesize)
+							* nand.pagesize);
+#endif
+
 	dbg_log(1, "NAND: Image: Copy %d bytes from %d to %d\r\n",
 			image->length, image->offset, image->dest);
 
@@ -1705,6 +2719,16 @@ int load_nandflash(struct image_info *image)
 		return ret;
 
 	if (image->of) {
+		bootstage_mark("nand_load_dtb");
+
+#if defined(CONFIG_LOAD_LINUX) || defined(CONFIG_LOAD_ANDROID)
+		length = update_image_length(&nand, image->of_offset,
+				image->of_length, image->of_dest, DT_BLOB);
+		if (length < 0)
+			return -1;
+
+		image->of_length = length;
+#endif
 		dbg_log(1, "NAND: dt blob: Copy %d bytes from %d to %d\r\n",
 			image->of_length, image->of_offset, image->of_dest);
 
@@ -1714,5 +2738,7 @@ int load_nandflash(struct image_info *image)
 			return ret;
 	}
 
+	nand_stats_report();
+
 	return 0;
  }
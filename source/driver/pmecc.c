@@ -0,0 +1,299 @@
+/* ----------------------------------------------------------------------------
+ *         ATMEL Microcontroller Software Support
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2013, Atmel Corporation
+
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the disclaimer below.
+ *
+ * Atmel's name may not be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * DISCLAIMER: THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "pmecc.h"
+
+/* Number of 4-bit digits of a partial syndrome */
+#define PMECC_SYN_DIGITS	4
+
+/*
+ * syn_table[n][d][v] is the contribution of the bits v of the digit d of
+ * the partial syndrome to the odd syndrome 2n+1.
+ */
+static short syn_table[PMECC_ERROR_CORR_BITS][PMECC_SYN_DIGITS][16];
+
+void pmecc_init_syn_table(struct _PMECC_paramDesc_struct *pmecc_params)
+{
+	short *alpha_to = pmecc_params->alpha_to;
+	unsigned int n, d, v, bit;
+	unsigned int i, j;
+
+	for (n = 0; n < PMECC_ERROR_CORR_BITS; n++) {
+		i = 2 * n + 1;
+		for (d = 0; d < PMECC_SYN_DIGITS; d++) {
+			syn_table[n][d][0] = 0;
+			for (v = 1; v < 16; v++) {
+				for (bit = 0; !(v & (1 << bit)); bit++)
+					;
+				j = d * 4 + bit;
+
+				/* Add the lowest bit of v to the other ones */
+				syn_table[n][d][v] = syn_table[n][d][v & (v - 1)];
+				if (j < pmecc_params->mm)
+					syn_table[n][d][v] ^= alpha_to[i * j];
+			}
+		}
+	}
+}
+
+/*
+ * Reduce a sum of at most three field element indexes modulo nn,
+ * without a division.
+ */
+static inline int gf_mod(int x, int nn)
+{
+	if (x >= nn)
+		x -= nn;
+	if (x >= nn)
+		x -= nn;
+
+	return x;
+}
+
+/**
+ * \brief The substitute function evaluates the polynomial remainder,
+ * with different values of the field primitive elements.
+ * \param pPmeccDescriptor Pointer to a PMECC_paramDesc instance.
+ */
+int pmecc_substitute(struct _PMECC_paramDesc_struct *pPmeccDescriptor)
+{
+	int i, j, n;
+	short *si;
+	short *pPartialSyn = pPmeccDescriptor->partialSyn;
+	short *alpha_to = pPmeccDescriptor->alpha_to;
+	short *index_of = pPmeccDescriptor->index_of;
+	unsigned short syn;
+
+	/*
+	 * si[] is a table that holds the current syndrome value,
+	 * an element of that table belongs to the field.
+	 */
+	si = pPmeccDescriptor->si;
+
+	for (i = 1; i < 2 * TT_MAX; i++)
+		si[i] = 0;
+
+	/* Computation 2t syndromes based on S(x) */
+	/* Odd syndromes, by 4-bit digits of S(x) */
+	for (i = 1, n = 0; n < pPmeccDescriptor->tt; i = i + 2, n++) {
+		syn = (unsigned short)pPartialSyn[i];
+		si[i] = syn_table[n][0][syn & 0xf]
+			^ syn_table[n][1][(syn >> 4) & 0xf]
+			^ syn_table[n][2][(syn >> 8) & 0xf]
+			^ syn_table[n][3][(syn >> 12) & 0xf];
+	}
+	/* Even syndrome = (Odd syndrome) ** 2 */
+	for (i = 2; i <= 2 * pPmeccDescriptor->tt; i = i + 2) {
+		j = i / 2;
+		if (si[j] == 0)
+			si[i] = 0;
+		else
+			si[i] = alpha_to[gf_mod(2 * index_of[si[j]],
+						pPmeccDescriptor->nn)];
+	}
+
+	return 0;
+}
+
+/*
+ * \brief The substitute function finding the value of the error
+ * location polynomial.
+ * \param pPmeccDescriptor Pointer to a PMECC_paramDesc instance.
+ */
+unsigned int pmecc_get_sigma(struct _PMECC_paramDesc_struct *pPmeccDescriptor)
+{
+	unsigned int dmu_0_count;
+	int i, j, k;
+	short *lmu = pPmeccDescriptor->lmu;
+	short *si = pPmeccDescriptor->si;
+	short tt = pPmeccDescriptor->tt;
+	short *alpha_to = pPmeccDescriptor->alpha_to;
+	short *index_of = pPmeccDescriptor->index_of;
+	int nn = pPmeccDescriptor->nn;
+	int scale;
+
+	/* mu  */
+	int mu[TT_MAX+1];
+
+	/* discrepancy */
+	int dmu[TT_MAX+1];
+
+	/* delta order   */
+	int delta[TT_MAX+1];
+
+	/* index of largest delta */
+	int ro;
+	int largest;
+	int diff;
+
+	dmu_0_count = 0;
+
+	/* First Row  */
+
+	/* Mu */
+	mu[0]  = -1;
+	/* Actually -1/2 */
+	/* Sigma(x) set to 1 */
+
+	for (i = 0; i < (2 * TT_MAX + 1); i++)
+		pPmeccDescriptor->smu[0][i] = 0;
+
+	pPmeccDescriptor->smu[0][0] = 1;
+
+	/* discrepancy set to 1 */
+	dmu[0] = 1;
+
+	/* polynom order set to 0 */
+	lmu[0] = 0;
+
+	/* delta set to -1 */
+	delta[0]  = (mu[0] * 2 - lmu[0]) >> 1;
+
+	/*                     */
+	/*     Second Row      */
+	/*                     */
+
+	/* Mu */
+	mu[1]  = 0;
+
+	/* Sigma(x) set to 1 */
+	for (i = 0; i < (2 * TT_MAX + 1); i++)
+		pPmeccDescriptor->smu[1][i] = 0;
+
+	pPmeccDescriptor->smu[1][0] = 1;
+
+	/* discrepancy set to S1 */
+	dmu[1] = si[1];
+
+	/* polynom order set to 0 */
+	lmu[1] = 0;
+
+	/* delta set to 0 */
+	delta[1]  = (mu[1] * 2 - lmu[1]) >> 1;
+
+	/* Init the Sigma(x) last row */
+	for (i = 0; i < (2 * TT_MAX + 1); i++)
+		pPmeccDescriptor->smu[tt + 1][i] = 0;
+
+	for (i = 1; i <= tt; i++) {
+		mu[i+1] = i << 1;
+		/* Compute Sigma (Mu+1)             */
+		/* And L(mu)                        */
+		/* check if discrepancy is set to 0 */
+		if (dmu[i] == 0) {
+			dmu_0_count++;
+			if ((tt - (lmu[i] >> 1) - 1) & 0x1) {
+				if (dmu_0_count
+					== ((tt - (lmu[i] >> 1) - 1) / 2) + 2) {
+					for (j = 0; j <= (lmu[i] >> 1) + 1; j++)
+						pPmeccDescriptor->smu[tt+1][j]
+						= pPmeccDescriptor->smu[i][j];
+
+					lmu[tt + 1] = lmu[i];
+					return 0;
+				}
+			} else {
+				if (dmu_0_count
+					== ((tt - (lmu[i] >> 1) - 1) / 2) + 1) {
+					for (j = 0; j <= (lmu[i] >> 1) + 1; j++)
+						pPmeccDescriptor->smu[tt + 1][j]
+						= pPmeccDescriptor->smu[i][j];
+
+					lmu[tt + 1] = lmu[i];
+					return 0;
+				}
+			}
+
+			/* copy polynom */
+			for (j = 0; j <= lmu[i] >> 1; j++)
+				pPmeccDescriptor->smu[i + 1][j]
+						= pPmeccDescriptor->smu[i][j];
+
+			/* copy previous polynom order to the next */
+			lmu[i + 1] = lmu[i];
+		} else {
+			ro = 0;
+			largest = -1;
+			/* find largest delta with dmu != 0 */
+			for (j = 0; j < i; j++) {
+				if (dmu[j]) {
+					if (delta[j] > largest) {
+						largest = delta[j];
+						ro = j;
+					}
+				}
+			}
+
+			/* compute difference */
+			diff = (mu[i] - mu[ro]);
+
+			/* Compute degree of the new smu polynomial */
+			if ((lmu[i]>>1) > ((lmu[ro]>>1) + diff))
+				lmu[i + 1] = lmu[i];
+			else
+				lmu[i + 1] = ((lmu[ro]>>1) + diff) * 2;
+
+			/* Init smu[i+1] with 0 */
+			for (k = 0; k < (2 * TT_MAX+1); k++)
+				pPmeccDescriptor->smu[i+1][k] = 0;
+
+			/* Compute smu[i+1], scaled by dmu[i] / dmu[ro] */
+			scale = index_of[dmu[i]] + (nn - index_of[dmu[ro]]);
+			for (k = 0; k <= lmu[ro]>>1; k++)
+				if (pPmeccDescriptor->smu[ro][k])
+					pPmeccDescriptor->smu[i + 1][k + diff] = alpha_to[gf_mod(scale
+						+ index_of[pPmeccDescriptor->smu[ro][k]], nn)];
+
+			for (k = 0; k <= lmu[i]>>1; k++)
+				pPmeccDescriptor->smu[i+1][k] ^= pPmeccDescriptor->smu[i][k];
+		}
+
+		/*************************************************/
+		/*                                               */
+		/*      End Compute Sigma (Mu+1)                 */
+		/*      And L(mu)                                */
+		/*************************************************/
+		/* In either case compute delta */
+		delta[i + 1]  = (mu[i + 1] * 2 - lmu[i + 1]) >> 1;
+
+		/* Do not compute discrepancy for the last iteration */
+		if (i < tt) {
+			for (k = 0 ; k <= (lmu[i + 1] >> 1); k++) {
+				if (k == 0)
+					dmu[i + 1] = si[2 * (i - 1) + 3];
+				/*
+				 * check if one operand of the multiplier
+				 * is null, its index is -1
+				 */
+				else if (pPmeccDescriptor->smu[i+1][k] && si[2 * (i - 1) + 3 - k])
+					dmu[i + 1] = alpha_to[gf_mod(index_of[pPmeccDescriptor->smu[i + 1][k]]
+							+ index_of[si[2 * (i - 1) + 3 - k]], nn)] ^ dmu[i + 1];
+			}
+		}
+	}
+	return 0;
+}
@@ -28,18 +28,37 @@
 #include "common.h"
 #include "hardware.h"
 #include "board.h"
+#include "string.h"
+#include "bootstage.h"
 
 #include "ff.h"
 
 #include "debug.h"
 
-#define CHUNK_SIZE	0x40000
+/*
+ * Read the rest of the file in a single f_read() call, so the contiguous
+ * cluster runs of the file go to the card as large multiple block reads.
+ */
+static FRESULT sdcard_read_file(FIL *file, BYTE *dest)
+{
+	UINT	byte_to_read = f_size(file) - file->fptr;
+	UINT	byte_read = 0;
+	FRESULT	fret;
+
+	fret = f_read(file, (void *)(dest), byte_to_read, &byte_read);
+	if ((fret == FR_OK) && (byte_read != byte_to_read))
+		fret = FR_DISK_ERR;
+
+	return fret;
+}
 
-static int sdcard_loadimage(char *filename, BYTE *dest)
+/*
+ * Load filename to dest. If end is not 0, the file must not run past it.
+ */
+static int sdcard_loadimage(char *filename, BYTE *dest,
+				unsigned int end, unsigned int *length)
 {
 	FIL 	file;
-	UINT	byte_to_read = CHUNK_SIZE;
-	UINT	byte_read;
 	FRESULT	fret;
 	int	ret;
 
@@ -50,17 +69,23 @@ static int sdcard_loadimage(char *filename, BYTE *dest)
 		goto open_fail;
 	}
 
-	do {
-		byte_read = 0;
-		fret = f_read(&file, (void *)(dest), byte_to_read, &byte_read);
-		dest += byte_to_read;
-	} while (byte_read >= byte_to_read);
+	if (end && (((unsigned int)dest > end)
+			|| (f_size(&file) > end - (unsigned int)dest))) {
+		dbg_log(1, "*** SD/MMC: %s: %d bytes at %d run past %d\n\r",
+				filename, f_size(&file), dest, end);
+		ret = -1;
+		goto read_fail;
+	}
 
+	fret = sdcard_read_file(&file, dest);
 	if (fret != FR_OK) {
 		dbg_log(1, "*** FATFS: f_read: error\n\r");
 		 ret = -1;
 		goto read_fail;
 	}
+
+	if (length)
+		*length = f_size(&file);
 	ret = 0;
 
 read_fail:
@@ -71,12 +96,92 @@ open_fail:
 
 }
 
+#if defined(CONFIG_LOAD_LINUX) || defined(CONFIG_LOAD_ANDROID)
+#define KERNEL_HEADER_CHUNK	512
+
+/*
+ * Read the first sector of the kernel to image->dest, look at the uImage
+ * header, then read the rest of the file so that the payload lands right
+ * at the kernel load address. image->dest is updated to the new location.
+ */
+static int sdcard_loadkernel(struct image_info *image)
+{
+	FIL 	file;
+	UINT	byte_read;
+	BYTE	*dest;
+	FRESULT	fret;
+	int	ret;
+
+	fret = f_open(&file, image->filename, FA_OPEN_EXISTING | FA_READ);
+	if (fret != FR_OK) {
+		dbg_log(1, "*** FATFS: f_open, filename: [%s]: error\n\r",
+							image->filename);
+		ret = -1;
+		goto open_fail;
+	}
+
+	byte_read = 0;
+	fret = f_read(&file, (void *)image->dest,
+				KERNEL_HEADER_CHUNK, &byte_read);
+	if (fret != FR_OK) {
+		dbg_log(1, "*** FATFS: f_read: error\n\r");
+		ret = -1;
+		goto read_fail;
+	}
+
+	if (kernel_size(image->dest) < 0) {
+		ret = -1;
+		goto read_fail;
+	}
+
+	dest = kernel_image_dest(image, f_size(&file));
+	if (dest != image->dest) {
+		memmove(dest, image->dest, byte_read);
+		image->dest = dest;
+	}
+
+	if (byte_read == KERNEL_HEADER_CHUNK) {
+		fret = sdcard_read_file(&file, dest + KERNEL_HEADER_CHUNK);
+		if (fret != FR_OK) {
+			dbg_log(1, "*** FATFS: f_read: error\n\r");
+			ret = -1;
+			goto read_fail;
+		}
+	}
+	ret = 0;
+
+read_fail:
+	fret = f_close(&file);
+
+open_fail:
+	return ret;
+}
+#endif
+
+#ifdef CONFIG_DEBUG
+static void sdcard_fatcache_report(void)
+{
+	DWORD	hit, miss;
+
+	f_fatcache_stat(&hit, &miss);
+	dbg_log(1, "SD/MMC: FAT cache: %d hits, %d misses\n\r", hit, miss);
+}
+#else
+static inline void sdcard_fatcache_report(void) {}
+#endif
+
+/*
+ * Everything to boot is read under a single mount: the card is identified
+ * on the first access to the volume and stays initialized for the kernel,
+ * the device tree blob and the initial ramdisk.
+ */
 int load_sdcard(struct image_info *image)
 {
 	FATFS	fs;
 	FRESULT	fret;
 	int	ret;
 
+	bootstage_mark("sdcard_init");
 	at91_mci0_hw_init();
 
 	/* mount fs */
@@ -86,45 +191,57 @@ int load_sdcard(struct image_info *image)
 		return -1;
 	}
 
+	bootstage_mark("sdcard_load_image");
+
 	dbg_log(1, "SD/MMC: Image: Read file %s to %d\n\r",
 					image->filename, image->dest);
 
-	ret = sdcard_loadimage(image->filename, image->dest);
+#if defined(CONFIG_LOAD_LINUX) || defined(CONFIG_LOAD_ANDROID)
+	ret = sdcard_loadkernel(image);
+#else
+	ret = sdcard_loadimage(image->filename, image->dest, 0, NULL);
+#endif
 	if (ret)
-		return ret;
-
-	/* umount fs */
-	fret = f_mount(0, NULL);
-	if (fret != FR_OK) {
-		dbg_log(1, "*** FATFS: f_mount umount error **\n\r");
-		return -1;
-	}
+		goto umount;
 
 	if (image->of) {
 		if (sdcard_set_of_name)
 			sdcard_set_of_name(image->of_filename);
 
-		/* mount fs */
-		fret = f_mount(0, &fs);
-		if (fret != FR_OK) {
-			dbg_log(1, "*** FATFS: f_mount error **\n\r");
-			return -1;
-		}
+		bootstage_mark("sdcard_load_dtb");
 
 		dbg_log(1, "SD/MMC: dt blob: Read file %s to %d\n\r",
 				image->of_filename, image->of_dest);
 
-		ret = sdcard_loadimage(image->of_filename, image->of_dest);
+		ret = sdcard_loadimage(image->of_filename,
+					image->of_dest, 0, NULL);
 		if (ret)
-			return ret;
+			goto umount;
+	}
 
-		/* umount fs */
-		fret = f_mount(0, NULL);
-		if (fret != FR_OK) {
-			dbg_log(1, "*** FATFS: f_mount umount error **\n\r");
-			return -1;
-		}
+	if (image->initrd) {
+		bootstage_mark("sdcard_load_initrd");
+
+		dbg_log(1, "SD/MMC: initrd: Read file %s to %d\n\r",
+				image->initrd_filename, image->initrd_dest);
+
+		ret = sdcard_loadimage(image->initrd_filename,
+					image->initrd_dest,
+					os_mem_end(),
+					&image->initrd_length);
+		if (ret)
+			goto umount;
 	}
 
-	return 0;
+umount:
+	sdcard_fatcache_report();
+
+	/* umount fs */
+	fret = f_mount(0, NULL);
+	if (fret != FR_OK) {
+		dbg_log(1, "*** FATFS: f_mount umount error **\n\r");
+		return -1;
+	}
+
+	return ret;
 }
@@ -0,0 +1,252 @@
+/* ----------------------------------------------------------------------------
+ *         ATMEL Microcontroller Software Support
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2013, Atmel Corporation
+
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the disclaimer below.
+ *
+ * Atmel's name may not be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * DISCLAIMER: THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include "common.h"
+#include "hardware.h"
+#include "board.h"
+#include "string.h"
+#include "bootstage.h"
+#include "media.h"
+
+#include "debug.h"
+
+#define SECTOR_SIZE		512
+#define SECTOR_SHIFT		9
+
+#define MBR_PART_TABLE		0x1be
+#define MBR_PART_ENTRY_SIZE	16
+#define MBR_PART_ENTRIES	4
+#define MBR_PART_TYPE		4
+#define MBR_PART_START		8
+#define MBR_SIGNATURE		0x1fe
+
+#define MBR_PART_TYPE_GPT	0xee
+
+#define GPT_HEADER_SECTOR	1
+#define GPT_PART_ENTRY_LBA	72
+#define GPT_PART_ENTRIES	80
+#define GPT_PART_ENTRY_SIZE	84
+#define GPT_PART_START		32
+
+#define GPT_PART_ENTRY_MIN	128
+
+static unsigned int get_le32(unsigned char *p)
+{
+	return p[0] | (p[1] << 8) | (p[2] << 16) | (p[3] << 24);
+}
+
+static int sdcard_read_sectors(unsigned int sector,
+				unsigned int count,
+				unsigned char *dest)
+{
+	if (sdcard_block_read(sector, count, dest) != count) {
+		dbg_log(1, "SD/MMC: Fail to read %d sectors at %d\n\r",
+						count, sector);
+		return -1;
+	}
+
+	return 0;
+}
+
+#if CONFIG_SDCARD_RAW_PART
+/*
+ * Look up the first sector of partition part (from 1) in the MBR, or in
+ * the GPT behind a protective MBR. buf holds one sector.
+ */
+static int sdcard_find_partition(unsigned int part,
+				unsigned char *buf,
+				unsigned int *start)
+{
+	unsigned char *entry;
+	unsigned int entry_size;
+	unsigned int offset;
+
+	if (sdcard_read_sectors(0, 1, buf))
+		return -1;
+
+	if ((buf[MBR_SIGNATURE] != 0x55) || (buf[MBR_SIGNATURE + 1] != 0xaa)) {
+		dbg_log(1, "SD/MMC: No partition table found\n\r");
+		return -1;
+	}
+
+	entry = buf + MBR_PART_TABLE;
+	if (entry[MBR_PART_TYPE] != MBR_PART_TYPE_GPT) {
+		if (part > MBR_PART_ENTRIES)
+			goto not_found;
+
+		entry += (part - 1) * MBR_PART_ENTRY_SIZE;
+		if (!entry[MBR_PART_TYPE])
+			goto not_found;
+
+		*start = get_le32(entry + MBR_PART_START);
+		return 0;
+	}
+
+	if (sdcard_read_sectors(GPT_HEADER_SECTOR, 1, buf))
+		return -1;
+
+	if (memcmp(buf, "EFI PART", 8)) {
+		dbg_log(1, "SD/MMC: No valid GPT header found\n\r");
+		return -1;
+	}
+
+	if (part > get_le32(buf + GPT_PART_ENTRIES))
+		goto not_found;
+
+	/* 128 << n bytes per entry, so that an entry never spans two sectors */
+	entry_size = get_le32(buf + GPT_PART_ENTRY_SIZE);
+	if ((entry_size < GPT_PART_ENTRY_MIN)
+			|| (entry_size & (entry_size - 1))) {
+		dbg_log(1, "SD/MMC: Bad GPT partition entry size: %d\n\r",
+							entry_size);
+		return -1;
+	}
+
+	offset = (part - 1) * entry_size;
+	if (sdcard_read_sectors(get_le32(buf + GPT_PART_ENTRY_LBA)
+				+ (offset >> SECTOR_SHIFT), 1, buf))
+		return -1;
+
+	entry = buf + (offset & (SECTOR_SIZE - 1));
+	*start = get_le32(entry + GPT_PART_START);
+	if (!*start)
+		goto not_found;
+
+	return 0;
+
+not_found:
+	dbg_log(1, "SD/MMC: Partition %d not found\n\r", part);
+	return -1;
+}
+#endif
+
+#if defined(CONFIG_LOAD_LINUX) || defined(CONFIG_LOAD_ANDROID)
+/*
+ * Read the first sector of the image to dest and return the length of
+ * the image given by its header.
+ */
+static int update_image_length(unsigned int sector,
+				unsigned int length,
+				unsigned char *dest,
+				unsigned char flag)
+{
+	if (sdcard_read_sectors(sector, 1, dest))
+		return -1;
+
+	return image_header_length(dest, length, flag);
+}
+#endif
+
+/*
+ * The images are read from fixed offsets of a partition, or of the whole
+ * card, each one with a single multiple block read: no file system is
+ * involved.
+ */
+int load_sdcard(struct image_info *image)
+{
+	unsigned int start = 0;
+	unsigned int sector;
+#if defined(CONFIG_LOAD_LINUX) || defined(CONFIG_LOAD_ANDROID)
+	int length;
+#endif
+	int ret;
+
+	/* The offsets are read as whole sectors */
+	if ((image->offset & (SECTOR_SIZE - 1))
+		|| (image->of && (image->of_offset & (SECTOR_SIZE - 1)))) {
+		dbg_log(1, "SD/MMC: Image offsets must be multiples " \
+					"of the 512 bytes sector\n\r");
+		return -1;
+	}
+
+	bootstage_mark("sdcard_init");
+	at91_mci0_hw_init();
+
+	if (sdcard_initialize()) {
+		dbg_log(1, "SD/MMC: Fail to initialize the card\n\r");
+		return -1;
+	}
+
+#if CONFIG_SDCARD_RAW_PART
+	/* The image destination is free to hold the partition table */
+	ret = sdcard_find_partition(CONFIG_SDCARD_RAW_PART,
+						image->dest, &start);
+	if (ret)
+		return ret;
+#endif
+
+	bootstage_mark("sdcard_load_image");
+
+	sector = start + (image->offset >> SECTOR_SHIFT);
+
+#if defined(CONFIG_LOAD_LINUX) || defined(CONFIG_LOAD_ANDROID)
+	length = update_image_length(sector, image->length,
+					image->dest, KERNEL_IMAGE);
+	if (length < 0)
+		return -1;
+
+	image->length = length;
+	image->dest = kernel_image_dest(image,
+			(length + SECTOR_SIZE - 1) & ~(SECTOR_SIZE - 1));
+#endif
+
+	dbg_log(1, "SD/MMC: Image: Copy %d bytes from sector %d to %d\n\r",
+				image->length, sector, image->dest);
+
+	ret = sdcard_read_sectors(sector,
+			(image->length + SECTOR_SIZE - 1) >> SECTOR_SHIFT,
+			image->dest);
+	if (ret)
+		return ret;
+
+	if (image->of) {
+		bootstage_mark("sdcard_load_dtb");
+
+		sector = start + (image->of_offset >> SECTOR_SHIFT);
+
+#if defined(CONFIG_LOAD_LINUX) || defined(CONFIG_LOAD_ANDROID)
+		length = update_image_length(sector, image->of_length,
+						image->of_dest, DT_BLOB);
+		if (length < 0)
+			return -1;
+
+		image->of_length = length;
+#endif
+
+		dbg_log(1, "SD/MMC: dt blob: Copy %d bytes " \
+				"from sector %d to %d\n\r",
+				image->of_length, sector, image->of_dest);
+
+		ret = sdcard_read_sectors(sector,
+			(image->of_length + SECTOR_SIZE - 1) >> SECTOR_SHIFT,
+			image->of_dest);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
@@ -52,6 +52,14 @@
 /* To enable fast seek feature, set _USE_FASTSEEK to 1. */
 
 
+#define	_FAT_CACHE_SECTORS	8	/* 0:Disable or 1-255:Number of sectors */
+/* The _FAT_CACHE_SECTORS option keeps that many consecutive FAT sectors in a
+/  static buffer, read ahead in a single disk_read call, so that following a
+/  cluster chain does not read the FAT one sector at a time. The buffer takes
+/  _FAT_CACHE_SECTORS * _MAX_SS bytes of RAM. 8 sectors cover the chain of a
+/  4 MB file with 4 KB clusters on FAT32. Requires _FS_READONLY = 1. */
+
+
 
 /*---------------------------------------------------------------------------/
 / Locale and Namespace Configurations
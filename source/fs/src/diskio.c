@@ -23,6 +23,9 @@ DSTATUS disk_initialize(BYTE drv        /* Physical drive number (0..) */
 {
 	if (drv) return STA_NOINIT;	
 	
+	/* The card is identified once per boot */
+	if (!(Stat & STA_NOINIT)) return Stat;
+
 	if (sdcard_initialize() == 0)
 		Stat &= ~STA_NOINIT;
 
@@ -48,7 +51,7 @@ DSTATUS disk_status(BYTE drv    /* Physical drive number (0..) */
 DRESULT disk_read(BYTE drv,     /* Physical drive number (0..) */
                   BYTE *buff,  /* Data buffer to store read data */
                   DWORD sector, /* Start sector number (LBA) */
-                  BYTE count    /* Sector count (1..255) */
+                  UINT count    /* Sector count */
     )
 {
 	if (drv || !count) return RES_PARERR;
@@ -132,6 +132,12 @@
 #define	ABORT(fs, res)		{ fp->flag |= FA__ERROR; LEAVE_FF(fs, res); }
 
 
+/* FAT cache */
+#if _FAT_CACHE_SECTORS && !_FS_READONLY
+#error _FAT_CACHE_SECTORS must be 0 on read/write cfg.
+#endif
+
+
 /* File shareing feature */
 #if _FS_SHARE
 #if _FS_READONLY
@@ -472,6 +478,21 @@ FATFS *FatFs[_VOLUMES];	/* Pointer to the file system objects (logical drives) *
 static
 WORD Fsid;			/* File system mount ID */
 
+#if _FAT_CACHE_SECTORS
+static
+BYTE FatCache[_FAT_CACHE_SECTORS * _MAX_SS] __attribute__((aligned(4)));	/* Consecutive FAT sectors */
+static
+DWORD FatCacheSect;		/* First sector held in the FAT cache */
+static
+UINT FatCacheCnt;		/* Number of sectors held in the FAT cache, 0:Empty */
+static
+WORD FatCacheId;		/* Mount ID of the file system held in the FAT cache */
+#ifdef CONFIG_DEBUG
+static
+DWORD FatCacheHit, FatCacheMiss;	/* FAT cache statistics */
+#endif
+#endif
+
 #if _FS_RPATH
 static
 BYTE CurrVol;			/* Current drive */
@@ -810,6 +831,47 @@ DWORD clust2sect (	/* !=0: Sector number, 0: Failed - invalid cluster# */
 
 
 
+/*-----------------------------------------------------------------------*/
+/* FAT access - Load a FAT sector                                        */
+/*-----------------------------------------------------------------------*/
+
+static
+BYTE* fat_window (	/* Pointer to the sector data, 0: Disk error */
+	FATFS *fs,	/* File system object */
+	DWORD sector	/* FAT sector# to be loaded */
+)
+{
+#if _FAT_CACHE_SECTORS
+	UINT cnt;
+
+
+	if (FatCacheCnt && FatCacheId == fs->id && sector - FatCacheSect < FatCacheCnt) {
+#ifdef CONFIG_DEBUG
+		FatCacheHit++;
+#endif
+		return &FatCache[(sector - FatCacheSect) * SS(fs)];
+	}
+#ifdef CONFIG_DEBUG
+	FatCacheMiss++;
+#endif
+	cnt = (UINT)(fs->fatbase + fs->fsize - sector);	/* Read ahead up to the end of the FAT */
+	if (cnt > _FAT_CACHE_SECTORS) cnt = _FAT_CACHE_SECTORS;
+	FatCacheCnt = 0;
+	if (disk_read(fs->drv, FatCache, sector, cnt) != RES_OK)
+		return 0;
+	FatCacheSect = sector;
+	FatCacheCnt = cnt;
+	FatCacheId = fs->id;
+	return FatCache;
+#else
+	if (move_window(fs, sector)) return 0;
+	return fs->win;
+#endif
+}
+
+
+
+
 /*-----------------------------------------------------------------------*/
 /* FAT access - Read value of a FAT entry                                */
 /*-----------------------------------------------------------------------*/
@@ -830,20 +892,20 @@ DWORD get_fat (		/* 0xFFFFFFFF:Disk error, 1:Internal error, Else:Cluster status
 	switch (fs->fs_type) {
 	case FS_FAT12 :
 		bc = (UINT)clst; bc += bc / 2;
-		if (move_window(fs, fs->fatbase + (bc / SS(fs)))) break;
-		wc = fs->win[bc % SS(fs)]; bc++;
-		if (move_window(fs, fs->fatbase + (bc / SS(fs)))) break;
-		wc |= fs->win[bc % SS(fs)] << 8;
+		if (!(p = fat_window(fs, fs->fatbase + (bc / SS(fs))))) break;
+		wc = p[bc % SS(fs)]; bc++;
+		if (!(p = fat_window(fs, fs->fatbase + (bc / SS(fs))))) break;
+		wc |= p[bc % SS(fs)] << 8;
 		return (clst & 1) ? (wc >> 4) : (wc & 0xFFF);
 
 	case FS_FAT16 :
-		if (move_window(fs, fs->fatbase + (clst / (SS(fs) / 2)))) break;
-		p = &fs->win[clst * 2 % SS(fs)];
+		if (!(p = fat_window(fs, fs->fatbase + (clst / (SS(fs) / 2))))) break;
+		p += clst * 2 % SS(fs);
 		return LD_WORD(p);
 
 	case FS_FAT32 :
-		if (move_window(fs, fs->fatbase + (clst / (SS(fs) / 4)))) break;
-		p = &fs->win[clst * 4 % SS(fs)];
+		if (!(p = fat_window(fs, fs->fatbase + (clst / (SS(fs) / 4))))) break;
+		p += clst * 4 % SS(fs);
 		return LD_DWORD(p) & 0x0FFFFFFF;
 	}
 
@@ -2376,8 +2438,8 @@ FRESULT f_read (
 )
 {
 	FRESULT res;
-	DWORD clst, sect, remain;
-	UINT rcnt, cc;
+	DWORD clst, sect, remain, nclst = 0;
+	UINT rcnt, cc, ncc;
 	BYTE csect, *rbuff = buff;
 
 
@@ -2399,6 +2461,9 @@ FRESULT f_read (
 			if (!csect) {					/* On the cluster boundary? */
 				if (fp->fptr == 0) {			/* On the top of the file? */
 					clst = fp->sclust;		/* Follow from the origin */
+				} else if (nclst) {			/* Next cluster already read when the run was clipped */
+					clst = nclst;
+					nclst = 0;
 				} else {				/* Middle or end of the file */
 #if _USE_FASTSEEK
 					if (fp->cltbl)
@@ -2416,9 +2481,19 @@ FRESULT f_read (
 			sect += csect;
 			cc = btr / SS(fp->fs);				/* When remaining bytes >= sector size, */
 			if (cc) {					/* Read maximum contiguous sectors directly */
-				if (csect + cc > fp->fs->csize)		/* Clip at cluster boundary */
-					cc = fp->fs->csize - csect;
-				if (disk_read(fp->fs->drv, rbuff, sect, (BYTE)cc) != RES_OK)
+				ncc = fp->fs->csize - csect;		/* Extend over the following clusters while they are contiguous */
+				while (ncc < cc) {
+					clst = get_fat(fp->fs, fp->clust);
+					if (clst != fp->clust + 1) {
+						nclst = clst;		/* Keep it for the next cluster boundary */
+						break;
+					}
+					fp->clust = clst;
+					ncc += fp->fs->csize;
+				}
+				if (cc > ncc)				/* Clip at the end of the cluster run */
+					cc = ncc;
+				if (disk_read(fp->fs->drv, rbuff, sect, cc) != RES_OK)
 					ABORT(fp->fs, FR_DISK_ERR);
 #if !_FS_READONLY && _FS_MINIMIZE <= 2			/* Replace one of the read sectors with cached data if it contains a dirty sector */
 #if _FS_TINY
@@ -2464,6 +2539,26 @@ FRESULT f_read (
 
 
 
+/*-----------------------------------------------------------------------*/
+/* Get FAT Cache Statistics                                              */
+/*-----------------------------------------------------------------------*/
+
+void f_fatcache_stat (
+	DWORD *hit,		/* Pointer to the number of FAT sector hits */
+	DWORD *miss		/* Pointer to the number of FAT sector misses */
+)
+{
+#if _FAT_CACHE_SECTORS && defined(CONFIG_DEBUG)
+	*hit = FatCacheHit;
+	*miss = FatCacheMiss;
+#else
+	*hit = *miss = 0;
+#endif
+}
+
+
+
+
 #if !_FS_READONLY
 /*-----------------------------------------------------------------------*/
 /* Write File                                                            */
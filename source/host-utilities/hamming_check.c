@@ -0,0 +1,277 @@
+/* ----------------------------------------------------------------------------
+ *         ATMEL Microcontroller Software Support
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2013, Atmel Corporation
+
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the disclaimer below.
+ *
+ * Atmel's name may not be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * DISCLAIMER: THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Host check of the driver/hamming.c software ECC.
+ *
+ * Hamming_Compute256x() is compared with the Compute256() hamming.c had
+ * before the parity table (a copy is kept below), for random, erased and
+ * zeroed blocks at every buffer alignment. Hamming_Verify256x() must then
+ * correct any single data bitflip, report a flip in the ECC bytes and
+ * reject any double data bitflip. The throughput of both versions is
+ * printed with -b.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "hamming.h"
+
+#define PAGE_SIZE	2048
+#define ECC_SIZE	(PAGE_SIZE / 256 * 3)
+#define ROUNDS		20000
+
+/* Compute256() before the parity table, for reference */
+static unsigned char old_count_bits(unsigned char byte)
+{
+	unsigned char count = 0;
+
+	while (byte > 0) {
+		if (byte & 1)
+			count++;
+
+		byte >>= 1;
+	}
+
+	return count;
+}
+
+static void old_compute256(const unsigned char *data, unsigned char *code)
+{
+	unsigned int i;
+	unsigned char columnSum = 0;
+	unsigned char evenLineCode = 0;
+	unsigned char oddLineCode = 0;
+	unsigned char evenColumnCode = 0;
+	unsigned char oddColumnCode = 0;
+
+	for (i = 0; i < 256; i++) {
+		columnSum ^= data[i];
+
+		if ((old_count_bits(data[i]) & 1) == 1) {
+			evenLineCode ^= (255 - i);
+			oddLineCode ^= i;
+		}
+	}
+
+	for (i = 0; i < 8; i++) {
+		if (columnSum & 1) {
+			evenColumnCode ^= (7 - i);
+			oddColumnCode ^= i;
+		}
+		columnSum >>= 1;
+	}
+
+	code[0] = 0;
+	code[1] = 0;
+	code[2] = 0;
+
+	for (i = 0; i < 4; i++) {
+		code[0] <<= 2;
+		code[1] <<= 2;
+		code[2] <<= 2;
+
+		if ((oddLineCode & 0x80) != 0)
+			code[0] |= 2;
+		if ((evenLineCode & 0x80) != 0)
+			code[0] |= 1;
+
+		if ((oddLineCode & 0x08) != 0)
+			code[1] |= 2;
+		if ((evenLineCode & 0x08) != 0)
+			code[1] |= 1;
+
+		if ((oddColumnCode & 0x04) != 0)
+			code[2] |= 2;
+		if ((evenColumnCode & 0x04) != 0)
+			code[2] |= 1;
+
+		oddLineCode <<= 1;
+		evenLineCode <<= 1;
+		oddColumnCode <<= 1;
+		evenColumnCode <<= 1;
+	}
+
+	code[0] = ~code[0];
+	code[1] = ~code[1];
+	code[2] = ~code[2];
+}
+
+static void old_compute256x(const unsigned char *data,
+			unsigned int size, unsigned char *code)
+{
+	for (; size; size -= 256, data += 256, code += 3)
+		old_compute256(data, code);
+}
+
+static unsigned char buffer[PAGE_SIZE + 4];
+
+static void fill_page(unsigned char *page, unsigned int kind)
+{
+	unsigned int i;
+
+	for (i = 0; i < PAGE_SIZE; i++) {
+		switch (kind) {
+		case 0:
+			page[i] = 0xff;
+			break;
+		case 1:
+			page[i] = 0x00;
+			break;
+		default:
+			page[i] = rand();
+			break;
+		}
+	}
+}
+
+static int check_page(unsigned char *page)
+{
+	unsigned char old_code[ECC_SIZE], code[ECC_SIZE];
+	unsigned char copy[PAGE_SIZE];
+	unsigned int bit, bit2;
+	unsigned char ret;
+
+	old_compute256x(page, PAGE_SIZE, old_code);
+	Hamming_Compute256x(page, PAGE_SIZE, code);
+	if (memcmp(old_code, code, ECC_SIZE)) {
+		printf("Compute256: ECC bytes differ from the old code\n");
+		return -1;
+	}
+
+	memcpy(copy, page, PAGE_SIZE);
+
+	if (Hamming_Verify256x(page, PAGE_SIZE, code) != 0) {
+		printf("Verify256: clean page reported as bad\n");
+		return -1;
+	}
+
+	/* Single data bitflip: corrected */
+	bit = rand() % (PAGE_SIZE * 8);
+	page[bit >> 3] ^= 1 << (bit & 7);
+	ret = Hamming_Verify256x(page, PAGE_SIZE, code);
+	if ((ret != Hamming_ERROR_SINGLEBIT) || memcmp(page, copy, PAGE_SIZE)) {
+		printf("Verify256: bitflip %u not corrected (%u)\n", bit, ret);
+		return -1;
+	}
+
+	/* Bitflip in the ECC bytes */
+	bit = rand() % (ECC_SIZE * 8);
+	code[bit >> 3] ^= 1 << (bit & 7);
+	ret = Hamming_Verify256x(page, PAGE_SIZE, code);
+	code[bit >> 3] ^= 1 << (bit & 7);
+	if ((ret != Hamming_ERROR_ECC) || memcmp(page, copy, PAGE_SIZE)) {
+		printf("Verify256: ECC bitflip %u not reported (%u)\n",
+								bit, ret);
+		return -1;
+	}
+
+	/* Two data bitflips in the same 256-byte block: detected */
+	bit = rand() % (PAGE_SIZE * 8);
+	do {
+		bit2 = (bit & ~(256 * 8 - 1)) | (rand() % (256 * 8));
+	} while (bit2 == bit);
+	page[bit >> 3] ^= 1 << (bit & 7);
+	page[bit2 >> 3] ^= 1 << (bit2 & 7);
+	ret = Hamming_Verify256x(page, PAGE_SIZE, code);
+	if (ret != Hamming_ERROR_MULTIPLEBITS) {
+		printf("Verify256: bitflips %u and %u not detected (%u)\n",
+							bit, bit2, ret);
+		return -1;
+	}
+
+	return 0;
+}
+
+static int run_checks(void)
+{
+	unsigned int round, align;
+	unsigned char *page;
+
+	for (round = 0; round < ROUNDS; round++) {
+		align = round & 3;
+		page = buffer + align;
+
+		fill_page(page, (round < 8) ? (round >> 2) : 2);
+		if (check_page(page)) {
+			printf("round %u, buffer offset %u\n", round, align);
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static double bench(void (*fn)(const unsigned char *, unsigned int,
+				unsigned char *))
+{
+	unsigned char code[ECC_SIZE];
+	unsigned int i;
+	double t = now();
+
+	for (i = 0; i < ROUNDS; i++) {
+		fn(buffer, PAGE_SIZE, code);
+		__asm__ __volatile__("" : : : "memory");
+	}
+
+	return (double)PAGE_SIZE * ROUNDS / (now() - t) / 1e6;
+}
+
+int main(int argc, char *argv[])
+{
+	double old, new;
+
+	srand(1);
+
+	if (run_checks()) {
+		printf("hamming_check: FAILED\n");
+		return 1;
+	}
+	printf("hamming_check: ECC bytes match the old code, "
+				"single bitflips corrected\n");
+
+	if ((argc > 1) && !strcmp(argv[1], "-b")) {
+		fill_page(buffer, 2);
+		old = bench(old_compute256x);
+		new = bench(Hamming_Compute256x);
+		printf("Compute256: old %.0f MB/s, new %.0f MB/s, %.1fx\n",
+						old, new, new / old);
+	}
+
+	return 0;
+}
@@ -0,0 +1,475 @@
+/* ----------------------------------------------------------------------------
+ *         ATMEL Microcontroller Software Support
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2013, Atmel Corporation
+
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the disclaimer below.
+ *
+ * Atmel's name may not be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * DISCLAIMER: THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Host check of the software part of the PMECC correction, driver/pmecc.c.
+ *
+ * Random bitflips are put in a sector, for the 512-byte sectors (GF(2^13))
+ * and the 1024-byte ones (GF(2^14)). The partial syndromes the PMECC would
+ * give, the remainders of the error polynomial by the minimal polynomials
+ * of alpha^i, are computed here. pmecc_substitute() and pmecc_get_sigma()
+ * must then give the same syndromes and error location polynomial as the
+ * bit loop and mod() based code nandflash.c had before (a copy is kept
+ * below, calling the mod() of lib/div.c), and the roots of that polynomial must be the flipped bits.
+ * With -b the corrections per second of both versions are printed.
+ *
+ * Built once per correction capability, as PMECC_ERROR_CORR_BITS sizes
+ * the syndrome tables of pmecc.c.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "pmecc.h"
+
+/* lib/div.c, renamed not to clash with div() of the C library */
+extern unsigned int at91_mod(unsigned int dividend, unsigned int divisor);
+
+#define ROUNDS		20000
+#define MAX_BITS	(1024 * 8 + TT_MAX * 14)
+
+struct gf_field {
+	int mm;
+	unsigned int poly;
+	unsigned int sector_bits;	/* data and ECC bits of a sector */
+};
+
+static const struct gf_field fields[] = {
+	{ 13, 0x201b, 512 * 8 + PMECC_ERROR_CORR_BITS * 13 },
+	{ 14, 0x4443, 1024 * 8 + PMECC_ERROR_CORR_BITS * 14 },
+};
+
+static short alpha_to[(1 << 14) + 1];
+static short index_of[(1 << 14) + 1];
+
+/* rem[n][p]: x^p modulo the minimal polynomial of alpha^(2n+1) */
+static unsigned short rem[PMECC_ERROR_CORR_BITS][MAX_BITS];
+
+static struct _PMECC_paramDesc_struct desc, ref;
+
+static void build_field(const struct gf_field *field)
+{
+	int nn = (1 << field->mm) - 1;
+	unsigned int x = 1;
+	int i;
+
+	for (i = 0; i < nn; i++) {
+		alpha_to[i] = x;
+		index_of[x] = i;
+		x <<= 1;
+		if (x & (1 << field->mm))
+			x ^= field->poly;
+	}
+	alpha_to[nn] = 1;
+	index_of[0] = -1;
+
+	desc.tt = PMECC_ERROR_CORR_BITS;
+	desc.mm = field->mm;
+	desc.nn = nn;
+	desc.alpha_to = alpha_to;
+	desc.index_of = index_of;
+}
+
+static int gf_mul(int a, int b)
+{
+	if (!a || !b)
+		return 0;
+
+	return alpha_to[(index_of[a] + index_of[b]) % desc.nn];
+}
+
+/* Minimal polynomial of alpha^i, as a bit mask of its GF(2) coefficients */
+static unsigned int minimal_poly(int i)
+{
+	int coef[16] = { 1 };
+	int degree = 0;
+	int c = i % desc.nn;
+	unsigned int poly = 0;
+	int k;
+
+	/* Multiply by (x + alpha^c) over the conjugates c, 2c, 4c ... */
+	do {
+		for (k = degree + 1; k > 0; k--)
+			coef[k] = coef[k - 1] ^ gf_mul(coef[k], alpha_to[c]);
+		coef[0] = gf_mul(coef[0], alpha_to[c]);
+		degree++;
+		c = (c * 2) % desc.nn;
+	} while (c != i % desc.nn);
+
+	for (k = 0; k <= degree; k++) {
+		if (coef[k] > 1) {
+			printf("minimal polynomial of alpha^%d not binary\n", i);
+			exit(1);
+		}
+		poly |= coef[k] << k;
+	}
+
+	return poly;
+}
+
+static void build_remainders(const struct gf_field *field)
+{
+	unsigned int poly, r;
+	unsigned int degree;
+	unsigned int n, p;
+
+	for (n = 0; n < PMECC_ERROR_CORR_BITS; n++) {
+		poly = minimal_poly(2 * n + 1);
+		for (degree = 0; poly >> (degree + 1); degree++)
+			;
+
+		r = 1;
+		for (p = 0; p < field->sector_bits; p++) {
+			rem[n][p] = r;
+			r <<= 1;
+			if (r & (1 << degree))
+				r ^= poly;
+		}
+	}
+}
+
+/* substitute() and get_sigma() before pmecc.c, for reference */
+static int old_substitute(struct _PMECC_paramDesc_struct *pPmeccDescriptor)
+{
+	int i, j;
+	short *si;
+	short *pPartialSyn = pPmeccDescriptor->partialSyn;
+	short *alpha_to = pPmeccDescriptor->alpha_to;
+	short *index_of = pPmeccDescriptor->index_of;
+
+	si = pPmeccDescriptor->si;
+
+	for (i = 1; i < 2 * TT_MAX; i++)
+		si[i] = 0;
+
+	for (i = 1; i <= 2 * pPmeccDescriptor->tt - 1; i = i + 2) {
+		si[i] = 0;
+		for (j = 0; j < pPmeccDescriptor->mm; j++) {
+			if (pPartialSyn[i] & ((unsigned short)0x1 << j))
+				si[i] = alpha_to[(i * j)] ^ si[i];
+		}
+	}
+
+	for (i = 2; i <= 2 * pPmeccDescriptor->tt; i = i + 2) {
+		j = i / 2;
+		if (si[j] == 0)
+			si[i] = 0;
+		else
+			si[i] = alpha_to[at91_mod(2 * index_of[si[j]],
+						pPmeccDescriptor->nn)];
+	}
+
+	return 0;
+}
+
+static unsigned int old_get_sigma(struct _PMECC_paramDesc_struct *pPmeccDescriptor)
+{
+	unsigned int dmu_0_count;
+	int i, j, k;
+	short *lmu = pPmeccDescriptor->lmu;
+	short *si = pPmeccDescriptor->si;
+	short tt = pPmeccDescriptor->tt;
+	int mu[TT_MAX+1];
+	int dmu[TT_MAX+1];
+	int delta[TT_MAX+1];
+	int ro;
+	int largest;
+	int diff;
+
+	dmu_0_count = 0;
+
+	mu[0]  = -1;
+	for (i = 0; i < (2 * TT_MAX + 1); i++)
+		pPmeccDescriptor->smu[0][i] = 0;
+	pPmeccDescriptor->smu[0][0] = 1;
+	dmu[0] = 1;
+	lmu[0] = 0;
+	delta[0]  = (mu[0] * 2 - lmu[0]) >> 1;
+
+	mu[1]  = 0;
+	for (i = 0; i < (2 * TT_MAX + 1); i++)
+		pPmeccDescriptor->smu[1][i] = 0;
+	pPmeccDescriptor->smu[1][0] = 1;
+	dmu[1] = si[1];
+	lmu[1] = 0;
+	delta[1]  = (mu[1] * 2 - lmu[1]) >> 1;
+
+	for (i = 0; i < (2 * TT_MAX + 1); i++)
+		pPmeccDescriptor->smu[tt + 1][i] = 0;
+
+	for (i = 1; i <= tt; i++) {
+		mu[i+1] = i << 1;
+		if (dmu[i] == 0) {
+			dmu_0_count++;
+			if ((tt - (lmu[i] >> 1) - 1) & 0x1) {
+				if (dmu_0_count
+					== ((tt - (lmu[i] >> 1) - 1) / 2) + 2) {
+					for (j = 0; j <= (lmu[i] >> 1) + 1; j++)
+						pPmeccDescriptor->smu[tt+1][j]
+						= pPmeccDescriptor->smu[i][j];
+
+					lmu[tt + 1] = lmu[i];
+					return 0;
+				}
+			} else {
+				if (dmu_0_count
+					== ((tt - (lmu[i] >> 1) - 1) / 2) + 1) {
+					for (j = 0; j <= (lmu[i] >> 1) + 1; j++)
+						pPmeccDescriptor->smu[tt + 1][j]
+						= pPmeccDescriptor->smu[i][j];
+
+					lmu[tt + 1] = lmu[i];
+					return 0;
+				}
+			}
+
+			for (j = 0; j <= lmu[i] >> 1; j++)
+				pPmeccDescriptor->smu[i + 1][j]
+						= pPmeccDescriptor->smu[i][j];
+
+			lmu[i + 1] = lmu[i];
+		} else {
+			ro = 0;
+			largest = -1;
+			for (j = 0; j < i; j++) {
+				if (dmu[j]) {
+					if (delta[j] > largest) {
+						largest = delta[j];
+						ro = j;
+					}
+				}
+			}
+
+			diff = (mu[i] - mu[ro]);
+
+			if ((lmu[i]>>1) > ((lmu[ro]>>1) + diff))
+				lmu[i + 1] = lmu[i];
+			else
+				lmu[i + 1] = ((lmu[ro]>>1) + diff) * 2;
+
+			for (k = 0; k < (2 * TT_MAX+1); k++)
+				pPmeccDescriptor->smu[i+1][k] = 0;
+
+			for (k = 0; k <= lmu[ro]>>1; k++)
+				if (pPmeccDescriptor->smu[ro][k] && dmu[i])
+					pPmeccDescriptor->smu[i + 1][k + diff] = pPmeccDescriptor->alpha_to[at91_mod((pPmeccDescriptor->index_of[dmu[i]]
+						+ (pPmeccDescriptor->nn	- pPmeccDescriptor->index_of[dmu[ro]])
+						+ pPmeccDescriptor->index_of[pPmeccDescriptor->smu[ro][k]]), pPmeccDescriptor->nn)];
+
+			for (k = 0; k <= lmu[i]>>1; k++)
+				pPmeccDescriptor->smu[i+1][k] ^= pPmeccDescriptor->smu[i][k];
+		}
+
+		delta[i + 1]  = (mu[i + 1] * 2 - lmu[i + 1]) >> 1;
+
+		if (i < tt) {
+			for (k = 0 ; k <= (lmu[i + 1] >> 1); k++) {
+				if (k == 0)
+					dmu[i + 1] = si[2 * (i - 1) + 3];
+				else if (pPmeccDescriptor->smu[i+1][k] && si[2 * (i - 1) + 3 - k])
+					dmu[i + 1] = pPmeccDescriptor->alpha_to[at91_mod((pPmeccDescriptor->index_of[pPmeccDescriptor->smu[i + 1][k]]
+							+ pPmeccDescriptor->index_of[si[2 * (i - 1) + 3 - k]]), pPmeccDescriptor->nn)] ^ dmu[i + 1];
+			}
+		}
+	}
+	return 0;
+}
+
+/* Partial syndromes of nerr distinct random bitflips, returned in pos[] */
+static void make_errors(const struct gf_field *field,
+			unsigned int nerr, unsigned int *pos)
+{
+	unsigned int i, k, n;
+	unsigned short syn;
+
+	for (i = 0; i < nerr; i++) {
+		do {
+			pos[i] = rand() % field->sector_bits;
+			for (k = 0; k < i; k++)
+				if (pos[k] == pos[i])
+					break;
+		} while (k < i);
+	}
+
+	memset(desc.partialSyn, 0, sizeof(desc.partialSyn));
+	for (n = 0; n < PMECC_ERROR_CORR_BITS; n++) {
+		syn = 0;
+		for (i = 0; i < nerr; i++)
+			syn ^= rem[n][pos[i]];
+		desc.partialSyn[2 * n + 1] = syn;
+	}
+}
+
+static int same_results(void)
+{
+	int tt = desc.tt;
+	int degree = desc.lmu[tt + 1] >> 1;
+
+	if (memcmp(desc.si, ref.si, sizeof(desc.si)))
+		return 0;
+	if (desc.lmu[tt + 1] != ref.lmu[tt + 1])
+		return 0;
+
+	return !memcmp(desc.smu[tt + 1], ref.smu[tt + 1],
+				(degree + 1) * sizeof(desc.smu[0][0]));
+}
+
+/* Is alpha^-p a root of the error location polynomial? */
+static int is_root(unsigned int p)
+{
+	int tt = desc.tt;
+	int degree = desc.lmu[tt + 1] >> 1;
+	int x = alpha_to[(desc.nn - (p % desc.nn)) % desc.nn];
+	int xk = 1;
+	int sum = 0;
+	int k;
+
+	for (k = 0; k <= degree; k++) {
+		sum ^= gf_mul(desc.smu[tt + 1][k], xk);
+		xk = gf_mul(xk, x);
+	}
+
+	return sum == 0;
+}
+
+static int check_field(const struct gf_field *field)
+{
+	unsigned int pos[PMECC_ERROR_CORR_BITS];
+	unsigned int round, nerr, i;
+
+	build_field(field);
+	build_remainders(field);
+	pmecc_init_syn_table(&desc);
+
+	for (round = 0; round < ROUNDS; round++) {
+		nerr = round % (PMECC_ERROR_CORR_BITS + 1);
+		make_errors(field, nerr, pos);
+
+		/* Every other round, partial syndromes of any kind */
+		if (round & 1)
+			for (i = 1; i < 2 * PMECC_ERROR_CORR_BITS; i += 2)
+				desc.partialSyn[i] = rand() & ((1 << field->mm) - 1);
+
+		ref = desc;
+		old_substitute(&ref);
+		old_get_sigma(&ref);
+
+		pmecc_substitute(&desc);
+		pmecc_get_sigma(&desc);
+
+		if (!same_results()) {
+			printf("GF(2^%d), round %u: results differ from "
+				"the old code\n", field->mm, round);
+			return -1;
+		}
+
+		if (round & 1)
+			continue;
+
+		if ((desc.lmu[desc.tt + 1] >> 1) != nerr) {
+			printf("GF(2^%d), round %u: %u bitflips, sigma of "
+				"degree %d\n", field->mm, round, nerr,
+				desc.lmu[desc.tt + 1] >> 1);
+			return -1;
+		}
+
+		for (i = 0; i < nerr; i++) {
+			if (!is_root(pos[i])) {
+				printf("GF(2^%d), round %u: bitflip %u "
+					"not located\n", field->mm, round, pos[i]);
+				return -1;
+			}
+		}
+	}
+
+	return 0;
+}
+
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* Sectors with PMECC_ERROR_CORR_BITS bitflips corrected per second */
+static void bench_field(const struct gf_field *field)
+{
+	unsigned int pos[PMECC_ERROR_CORR_BITS];
+	double t, old, new;
+	unsigned int i;
+
+	build_field(field);
+	build_remainders(field);
+	pmecc_init_syn_table(&desc);
+	make_errors(field, PMECC_ERROR_CORR_BITS, pos);
+	ref = desc;
+
+	t = now();
+	for (i = 0; i < ROUNDS; i++) {
+		old_substitute(&ref);
+		old_get_sigma(&ref);
+	}
+	old = ROUNDS / (now() - t);
+
+	t = now();
+	for (i = 0; i < ROUNDS; i++) {
+		pmecc_substitute(&desc);
+		pmecc_get_sigma(&desc);
+	}
+	new = ROUNDS / (now() - t);
+
+	printf("GF(2^%d), %d bits: old %.0f, new %.0f sectors/s, %.1fx\n",
+		field->mm, PMECC_ERROR_CORR_BITS, old, new, new / old);
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned int i;
+
+	srand(PMECC_ERROR_CORR_BITS);
+
+	for (i = 0; i < sizeof(fields) / sizeof(fields[0]); i++) {
+		if (check_field(&fields[i])) {
+			printf("pmecc_check (%d bits): FAILED\n",
+						PMECC_ERROR_CORR_BITS);
+			return 1;
+		}
+	}
+	printf("pmecc_check (%d bits): sigma matches the old code, "
+		"bitflips located\n", PMECC_ERROR_CORR_BITS);
+
+	if ((argc > 1) && !strcmp(argv[1], "-b"))
+		for (i = 0; i < sizeof(fields) / sizeof(fields[0]); i++)
+			bench_field(&fields[i]);
+
+	return 0;
+}
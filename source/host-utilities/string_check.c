@@ -0,0 +1,255 @@
+/* ----------------------------------------------------------------------------
+ *         ATMEL Microcontroller Software Support
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2013, Atmel Corporation
+
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the disclaimer below.
+ *
+ * Atmel's name may not be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * DISCLAIMER: THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Host check of the lib/string.c memcpy/memset/memmove.
+ *
+ * lib/string.c is built with its functions renamed to at91_*, see the
+ * Makefile, and compared with the C library for random sizes, source and
+ * destination offsets and overlaps. Guard bytes around each buffer catch
+ * writes out of bounds. The throughput of the byte loops lib/string.c used
+ * to have and of the word burst versions is then printed per size class.
+ *
+ * These are host numbers: they show the ratio between the versions, not
+ * what the ARM926 or the Cortex-A5 reach.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+extern void *at91_memcpy(void *dst, const void *src, int cnt);
+extern void *at91_memset(void *dst, int val, int cnt);
+extern void *at91_memmove(void *dst, const void *src, unsigned int cnt);
+
+#define BUF_SIZE	4096
+#define GUARD		64
+#define ITERATIONS	200000
+
+static unsigned char ref[BUF_SIZE + 2 * GUARD];
+static unsigned char out[BUF_SIZE + 2 * GUARD];
+static unsigned char src[BUF_SIZE + 2 * GUARD];
+
+static void fill_random(unsigned char *p, unsigned int len)
+{
+	while (len--)
+		*p++ = rand();
+}
+
+static int check(const char *name, unsigned int n,
+			unsigned int doff, unsigned int soff,
+			void *ret, void *expected)
+{
+	if (ret != expected) {
+		printf("%s: size %u, dst +%u, src +%u: bad return value\n",
+						name, n, doff, soff);
+		return -1;
+	}
+
+	if (memcmp(ref, out, sizeof(out))) {
+		printf("%s: size %u, dst +%u, src +%u: mismatch\n",
+						name, n, doff, soff);
+		return -1;
+	}
+
+	return 0;
+}
+
+static int check_memcpy(unsigned int n, unsigned int doff, unsigned int soff)
+{
+	void *ret;
+
+	fill_random(src, sizeof(src));
+	fill_random(ref, sizeof(ref));
+	memcpy(out, ref, sizeof(out));
+
+	memcpy(ref + GUARD + doff, src + GUARD + soff, n);
+	ret = at91_memcpy(out + GUARD + doff, src + GUARD + soff, n);
+
+	return check("memcpy", n, doff, soff, ret, out + GUARD + doff);
+}
+
+static int check_memset(unsigned int n, unsigned int doff)
+{
+	int val = rand();
+	void *ret;
+
+	fill_random(ref, sizeof(ref));
+	memcpy(out, ref, sizeof(out));
+
+	memset(ref + GUARD + doff, val, n);
+	ret = at91_memset(out + GUARD + doff, val, n);
+
+	return check("memset", n, doff, 0, ret, out + GUARD + doff);
+}
+
+/* Source and destination both in the buffer, overlapping either way */
+static int check_memmove(unsigned int n, unsigned int doff, unsigned int soff)
+{
+	void *ret;
+
+	fill_random(ref, sizeof(ref));
+	memcpy(out, ref, sizeof(out));
+
+	memmove(ref + GUARD + doff, ref + GUARD + soff, n);
+	ret = at91_memmove(out + GUARD + doff, out + GUARD + soff, n);
+
+	return check("memmove", n, doff, soff, ret, out + GUARD + doff);
+}
+
+static int run_checks(void)
+{
+	unsigned int i, n, doff, soff;
+
+	/* Every small size against every alignment pair */
+	for (n = 0; n <= 80; n++)
+		for (doff = 0; doff < 8; doff++)
+			for (soff = 0; soff < 8; soff++) {
+				if (check_memcpy(n, doff, soff)
+					|| check_memmove(n, doff, soff))
+					return -1;
+				if ((soff == 0) && check_memset(n, doff))
+					return -1;
+			}
+
+	for (i = 0; i < 100000; i++) {
+		n = rand() % (BUF_SIZE / 2);
+		doff = rand() % (BUF_SIZE / 2);
+		soff = rand() % (BUF_SIZE / 2);
+
+		if (check_memcpy(n, doff, soff)
+				|| check_memset(n, doff)
+				|| check_memmove(n, doff, soff))
+			return -1;
+	}
+
+	return 0;
+}
+
+/* The byte loops lib/string.c had before the word bursts */
+static void *byte_memcpy(void *dst, const void *src, int cnt)
+{
+	char *d = (char *)dst;
+	const char *s = (const char *)src;
+
+	while (cnt--)
+		*d++ = *s++;
+
+	return d;
+}
+
+static void *byte_memset(void *dst, int val, int cnt)
+{
+	char *d = (char *)dst;
+
+	while (cnt--)
+		*d++ = (char)val;
+
+	return d;
+}
+
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static double bench_memcpy(void *(*fn)(void *, const void *, int),
+				unsigned int n, unsigned int soff)
+{
+	unsigned int loops = ITERATIONS * 64 / (n + 64);
+	unsigned int i;
+	double t = now();
+
+	for (i = 0; i < loops; i++) {
+		fn(out + GUARD, src + GUARD + soff, n);
+		__asm__ __volatile__("" : : : "memory");
+	}
+
+	return (double)n * loops / (now() - t) / 1e6;
+}
+
+static double bench_memset(void *(*fn)(void *, int, int), unsigned int n)
+{
+	unsigned int loops = ITERATIONS * 64 / (n + 64);
+	unsigned int i;
+	double t = now();
+
+	for (i = 0; i < loops; i++) {
+		fn(out + GUARD, i, n);
+		__asm__ __volatile__("" : : : "memory");
+	}
+
+	return (double)n * loops / (now() - t) / 1e6;
+}
+
+static void run_bench(void)
+{
+	static const unsigned int sizes[] = { 16, 64, 256, 1024, 4096 };
+	unsigned int i, n;
+
+	printf("\n%6s  %28s  %28s  %20s\n", "",
+		"memcpy aligned MB/s", "memcpy src+1 MB/s", "memset MB/s");
+	printf("%6s  %9s %9s %8s  %9s %9s %8s  %9s %9s\n", "size",
+		"bytes", "bursts", "ratio", "bytes", "bursts", "ratio",
+		"bytes", "bursts");
+
+	for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+		double ba, wa, bu, wu, bs, ws;
+
+		n = sizes[i];
+		ba = bench_memcpy(byte_memcpy, n, 0);
+		wa = bench_memcpy(at91_memcpy, n, 0);
+		bu = bench_memcpy(byte_memcpy, n, 1);
+		wu = bench_memcpy(at91_memcpy, n, 1);
+		bs = bench_memset(byte_memset, n);
+		ws = bench_memset(at91_memset, n);
+
+		printf("%6u  %9.0f %9.0f %7.1fx  %9.0f %9.0f %7.1fx  %9.0f %9.0f\n",
+			n, ba, wa, wa / ba, bu, wu, wu / bu, bs, ws);
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	srand(1);
+
+	if (run_checks()) {
+		printf("string_check: FAILED\n");
+		return 1;
+	}
+	printf("string_check: memcpy/memset/memmove match the C library\n");
+
+	if ((argc > 1) && !strcmp(argv[1], "-b"))
+		run_bench();
+
+	return 0;
+}
@@ -0,0 +1,115 @@
+/* ----------------------------------------------------------------------------
+ *         ATMEL Microcontroller Software Support
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2013, Atmel Corporation
+
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the disclaimer below.
+ *
+ * Atmel's name may not be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * DISCLAIMER: THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef __AT91_DMAC_H__
+#define __AT91_DMAC_H__
+
+/* DMAC Register Definitions */
+#define DMAC_GCFG	0x00	/* DMAC Global Configuration Register */
+#define DMAC_EN		0x04	/* DMAC Enable Register */
+#define DMAC_SREQ	0x08	/* DMAC Software Single Request Register */
+#define DMAC_CREQ	0x0C	/* DMAC Software Chunk Transfer Request Register */
+#define DMAC_LAST	0x10	/* DMAC Software Last Transfer Flag Register */
+#define DMAC_EBCIER	0x18	/* DMAC Error, Buffer Transfer and Chained Buffer Transfer Interrupt Enable Register */
+#define DMAC_EBCIDR	0x1C	/* DMAC Error, Buffer Transfer and Chained Buffer Transfer Interrupt Disable Register */
+#define DMAC_EBCIMR	0x20	/* DMAC Error, Buffer Transfer and Chained Buffer Transfer Interrupt Mask Register */
+#define DMAC_EBCISR	0x24	/* DMAC Error, Buffer Transfer and Chained Buffer Transfer Interrupt Status Register */
+#define DMAC_CHER	0x28	/* DMAC Channel Handler Enable Register */
+#define DMAC_CHDR	0x2C	/* DMAC Channel Handler Disable Register */
+#define DMAC_CHSR	0x30	/* DMAC Channel Handler Status Register */
+
+/* Channel registers, at DMAC_CH_OFFSET(n) */
+#define DMAC_CH_OFFSET(n)	(0x3C + ((n) * 0x28))
+#define DMAC_SADDR	0x00	/* DMAC Channel Source Address Register */
+#define DMAC_DADDR	0x04	/* DMAC Channel Destination Address Register */
+#define DMAC_DSCR	0x08	/* DMAC Channel Descriptor Address Register */
+#define DMAC_CTRLA	0x0C	/* DMAC Channel Control A Register */
+#define DMAC_CTRLB	0x10	/* DMAC Channel Control B Register */
+#define DMAC_CFG	0x14	/* DMAC Channel Configuration Register */
+#define DMAC_SPIP	0x18	/* DMAC Channel Source Picture-in-Picture Configuration Register */
+#define DMAC_DPIP	0x1C	/* DMAC Channel Destination Picture-in-Picture Configuration Register */
+
+#define DMAC_CHANNELS	8
+
+/* -------- DMAC_EN: (Offset: 0x04) DMAC Enable Register -------- */
+#define AT91C_DMAC_ENABLE	(0x1UL << 0)
+/* -------- DMAC_EBCISR: (Offset: 0x24) DMAC Interrupt Status Register -------- */
+#define AT91C_DMAC_BTC(n)	(0x1UL << (n))		/* Buffer Transfer Completed */
+#define AT91C_DMAC_CBTC(n)	(0x1UL << (8 + (n)))	/* Chained Buffer Transfer Completed */
+#define AT91C_DMAC_ERR(n)	(0x1UL << (16 + (n)))	/* Access Error */
+/* -------- DMAC_CHER/CHDR/CHSR: Channel Handler Registers -------- */
+#define AT91C_DMAC_ENA(n)	(0x1UL << (n))		/* Enable */
+#define AT91C_DMAC_DIS(n)	(0x1UL << (n))		/* Disable */
+
+/* -------- DMAC_CTRLA: (Offset: 0x0C) DMAC Channel Control A Register -------- */
+#define AT91C_DMAC_BTSIZE	(0xFFFFUL << 0)	/* Buffer Transfer Size, in source width units */
+#define AT91C_DMAC_SCSIZE	(0x7UL << 16)	/* Source Chunk Transfer Size */
+#define AT91C_DMAC_DCSIZE	(0x7UL << 20)	/* Destination Chunk Transfer Size */
+#define AT91C_DMAC_SRC_WIDTH	(0x3UL << 24)	/* Source Transfer Width */
+#define 	AT91C_DMAC_SRC_WIDTH_BYTE	(0x0UL << 24)
+#define 	AT91C_DMAC_SRC_WIDTH_HALF	(0x1UL << 24)
+#define 	AT91C_DMAC_SRC_WIDTH_WORD	(0x2UL << 24)
+#define AT91C_DMAC_DST_WIDTH	(0x3UL << 28)	/* Destination Transfer Width */
+#define 	AT91C_DMAC_DST_WIDTH_BYTE	(0x0UL << 28)
+#define 	AT91C_DMAC_DST_WIDTH_HALF	(0x1UL << 28)
+#define 	AT91C_DMAC_DST_WIDTH_WORD	(0x2UL << 28)
+#define AT91C_DMAC_DONE		(0x1UL << 31)
+
+/* -------- DMAC_CTRLB: (Offset: 0x10) DMAC Channel Control B Register -------- */
+#define AT91C_DMAC_SIF(n)	((n) << 0)	/* Source AHB Interface */
+#define AT91C_DMAC_DIF(n)	((n) << 4)	/* Destination AHB Interface */
+#define AT91C_DMAC_SRC_DSCR_DIS	(0x1UL << 16)	/* Source Descriptor Fetch Disable */
+#define AT91C_DMAC_DST_DSCR_DIS	(0x1UL << 20)	/* Destination Descriptor Fetch Disable */
+#define AT91C_DMAC_FC		(0x7UL << 21)	/* Flow Controller */
+#define 	AT91C_DMAC_FC_MEM2MEM		(0x0UL << 21)
+#define 	AT91C_DMAC_FC_MEM2PER		(0x1UL << 21)
+#define 	AT91C_DMAC_FC_PER2MEM		(0x2UL << 21)
+#define 	AT91C_DMAC_FC_PER2PER		(0x3UL << 21)
+#define AT91C_DMAC_SRC_INCR	(0x3UL << 24)	/* Source Address Incremental Type */
+#define 	AT91C_DMAC_SRC_INCR_INCREMENTING	(0x0UL << 24)
+#define 	AT91C_DMAC_SRC_INCR_DECREMENTING	(0x1UL << 24)
+#define 	AT91C_DMAC_SRC_INCR_FIXED		(0x2UL << 24)
+#define AT91C_DMAC_DST_INCR	(0x3UL << 28)	/* Destination Address Incremental Type */
+#define 	AT91C_DMAC_DST_INCR_INCREMENTING	(0x0UL << 28)
+#define 	AT91C_DMAC_DST_INCR_DECREMENTING	(0x1UL << 28)
+#define 	AT91C_DMAC_DST_INCR_FIXED		(0x2UL << 28)
+#define AT91C_DMAC_IEN		(0x1UL << 30)	/* Interrupt Enable Not */
+#define AT91C_DMAC_AUTO		(0x1UL << 31)	/* Automatic Multiple Buffer Transfer */
+
+/* -------- DMAC_CFG: (Offset: 0x14) DMAC Channel Configuration Register -------- */
+#define AT91C_DMAC_SRC_PER(n)	((n) << 0)	/* Source Hardware Handshaking Interface */
+#define AT91C_DMAC_DST_PER(n)	((n) << 4)	/* Destination Hardware Handshaking Interface */
+#define AT91C_DMAC_SRC_H2SEL	(0x1UL << 9)	/* Source Hardware Handshaking Selection */
+#define AT91C_DMAC_DST_H2SEL	(0x1UL << 13)	/* Destination Hardware Handshaking Selection */
+#define AT91C_DMAC_SOD		(0x1UL << 16)	/* Stop On Done */
+#define AT91C_DMAC_AHB_PROT(n)	((n) << 24)	/* AHB Protection */
+#define AT91C_DMAC_FIFOCFG	(0x3UL << 28)	/* FIFO Configuration */
+#define 	AT91C_DMAC_FIFOCFG_ALAP		(0x0UL << 28)
+#define 	AT91C_DMAC_FIFOCFG_HALF		(0x1UL << 28)
+#define 	AT91C_DMAC_FIFOCFG_ASAP		(0x2UL << 28)
+
+#endif /* #ifndef __AT91_DMAC_H__ */
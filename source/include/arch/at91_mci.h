@@ -54,6 +54,19 @@
 
 #define MCI_FIFO	0x200	/* MCI FIFO Aperture Register */
 
+/* PDC of the MCI, on the parts without HSMCI */
+#define MCI_RPR		0x100	/* PDC Receive Pointer Register */
+#define MCI_RCR		0x104	/* PDC Receive Counter Register */
+#define MCI_RNPR	0x110	/* PDC Receive Next Pointer Register */
+#define MCI_RNCR	0x114	/* PDC Receive Next Counter Register */
+#define MCI_PTCR	0x120	/* PDC Transfer Control Register */
+
+/*-------- MCI_PTCR : (MCI Offset: 0x120) PDC Transfer Control Register -----*/
+#define AT91C_MCI_PDC_RXTEN	(0x1UL << 0)	/* Receiver Transfer Enable */
+#define AT91C_MCI_PDC_RXTDIS	(0x1UL << 1)	/* Receiver Transfer Disable */
+#define AT91C_MCI_PDC_TXTEN	(0x1UL << 8)	/* Transmitter Transfer Enable */
+#define AT91C_MCI_PDC_TXTDIS	(0x1UL << 9)	/* Transmitter Transfer Disable */
+
 /*-------- MCI_CR : (MCI Offset: 0x0) MCI Control Register --------*/
 #define AT91C_MCI_MCIEN		(0x1UL << 0)	/* Multimedia Interface Enable*/
 #define AT91C_MCI_MCIDIS	(0x1UL << 1)	/* Multimedia Interface Disable */
@@ -0,0 +1,85 @@
+/* ----------------------------------------------------------------------------
+ *         ATMEL Microcontroller Software Support
+ * ----------------------------------------------------------------------------
+ * Copyright (c) 2013, Atmel Corporation
+
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the disclaimer below.
+ *
+ * Atmel's name may not be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * DISCLAIMER: THIS SOFTWARE IS PROVIDED BY ATMEL "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NON-INFRINGEMENT ARE
+ * DISCLAIMED. IN NO EVENT SHALL ATMEL BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA,
+ * OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef __AT91_NFC_H__
+#define __AT91_NFC_H__
+
+/* NFC Register Definitions, in the SMC */
+#define NFC_CFG		0x00	/* NFC Configuration Register */
+#define NFC_CTRL	0x04	/* NFC Control Register */
+#define NFC_SR		0x08	/* NFC Status Register */
+#define NFC_IER		0x0C	/* NFC Interrupt Enable Register */
+#define NFC_IDR		0x10	/* NFC Interrupt Disable Register */
+#define NFC_IMR		0x14	/* NFC Interrupt Mask Register */
+#define NFC_ADDR	0x18	/* NFC Address Cycle Zero Register */
+#define NFC_BANK	0x1C	/* NFC Bank Register */
+
+/* -------- NFC_CFG: (Offset: 0x00) NFC Configuration Register -------- */
+#define AT91C_NFC_PAGESIZE	(0x7UL << 0)	/* Page Size */
+#define 	AT91C_NFC_PAGESIZE_512		(0x0UL << 0)
+#define 	AT91C_NFC_PAGESIZE_1024		(0x1UL << 0)
+#define 	AT91C_NFC_PAGESIZE_2048		(0x2UL << 0)
+#define 	AT91C_NFC_PAGESIZE_4096		(0x3UL << 0)
+#define 	AT91C_NFC_PAGESIZE_8192		(0x4UL << 0)
+#define AT91C_NFC_WSPARE	(0x1UL << 8)	/* Write Spare Area */
+#define AT91C_NFC_RSPARE	(0x1UL << 9)	/* Read Spare Area */
+#define AT91C_NFC_EDGECTRL	(0x1UL << 12)	/* Rising/Falling Edge Detection Control */
+#define AT91C_NFC_RBEDGE	(0x1UL << 13)	/* Ready/Busy Signal Edge Detection */
+#define AT91C_NFC_DTOCYC	(0xFUL << 16)	/* Data Timeout Cycle Number */
+#define AT91C_NFC_DTOMUL	(0x7UL << 20)	/* Data Timeout Multiplier */
+#define AT91C_NFC_SPARESIZE(x)	((((x) >> 2) - 1) << 24)	/* Spare Size, in bytes */
+
+/* -------- NFC_CTRL: (Offset: 0x04) NFC Control Register -------- */
+#define AT91C_NFC_ENABLE	(0x1UL << 0)
+#define AT91C_NFC_DISABLE	(0x1UL << 1)
+
+/* -------- NFC_SR: (Offset: 0x08) NFC Status Register -------- */
+#define AT91C_NFC_SMCSTS	(0x1UL << 0)	/* NAND Flash Controller Status */
+#define AT91C_NFC_BUSY		(0x1UL << 8)	/* NFC Busy */
+#define AT91C_NFC_XFRDONE	(0x1UL << 16)	/* NFC Data Transfer Terminated */
+#define AT91C_NFC_CMDDONE	(0x1UL << 17)	/* Command Done */
+#define AT91C_NFC_DTOE		(0x1UL << 20)	/* Data Timeout Error */
+#define AT91C_NFC_UNDEF		(0x1UL << 21)	/* Undefined Area Error */
+#define AT91C_NFC_AWB		(0x1UL << 22)	/* Accessing While Busy */
+#define AT91C_NFC_NFCASE	(0x1UL << 23)	/* NFC Access Size Error */
+#define AT91C_NFC_RB_EDGE0	(0x1UL << 24)	/* Ready/Busy Line 0 Edge Detected */
+
+/*
+ * NFC commands: written at AT91C_BASE_NFC_CMD + the command below, with
+ * the address cycles 1 to 4 as data (cycle 0 in NFC_ADDR if 5 cycles).
+ */
+#define AT91C_NFC_CMD1(x)	(((x) & 0xFF) << 2)	/* Command for Cycle 1 */
+#define AT91C_NFC_CMD2(x)	(((x) & 0xFF) << 10)	/* Command for Cycle 2 */
+#define AT91C_NFC_VCMD2		(0x1UL << 18)		/* Valid Cycle 2 Command */
+#define AT91C_NFC_ACYCLE(x)	(((x) & 0x7) << 19)	/* Number of Address Cycles */
+#define AT91C_NFC_CSID(x)	(((x) & 0x7) << 22)	/* Chip Select Identifier */
+#define AT91C_NFC_DATAEN	(0x1UL << 25)		/* Data Transfer Enable */
+#define AT91C_NFC_NFCRD		(0x0UL << 26)		/* NFC Read */
+#define AT91C_NFC_NFCWR		(0x1UL << 26)		/* NFC Write */
+#define AT91C_NFC_NFCBUSY	(0x1UL << 27)		/* NFC Busy, when read */
+
+#endif /* #ifndef __AT91_NFC_H__ */
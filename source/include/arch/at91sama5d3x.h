@@ -177,6 +177,7 @@
 /*
  * Other misc defines
  */
+#define AT91C_BASE_NFC		(AT91C_BASE_SMC + 0x00)
 #define AT91C_BASE_PMECC	(AT91C_BASE_SMC + 0x70)
 #define AT91C_BASE_PMERRLOC	(AT91C_BASE_SMC + 0x500)
 
@@ -52,10 +52,27 @@ struct image_info
 	unsigned int of_length;
 	char *of_filename;
 	unsigned char *of_dest;
+
+	unsigned char initrd;
+	unsigned int initrd_length;
+	char *initrd_filename;
+	unsigned char *initrd_dest;
 };
 
+/* image type, used to work out the real length of an image */
+#define KERNEL_IMAGE	0x01
+#define DT_BLOB		0x02
+
 extern void (*sdcard_set_of_name)(char *);
 
+extern int kernel_size(unsigned char *addr);
+extern int image_header_length(unsigned char *addr,
+				unsigned int length,
+				unsigned char flag);
+extern unsigned int os_mem_end(void);
+extern unsigned char *kernel_image_dest(struct image_info *image,
+					unsigned int length);
+
 static inline unsigned int swap_uint32(unsigned int data)
 {
 	volatile unsigned int a, b, c, d;
@@ -152,6 +152,8 @@ struct sd_card {
 	unsigned int	bus_width_support;
 	unsigned int	highspeed_card;
 	unsigned int	read_bl_len;
+	unsigned int	block_len;	/* set by SET_BLOCKLEN, 0 if unknown */
+	unsigned int	set_block_count; /* SET_BLOCK_COUNT supported */
 
 	struct sdcard_register	*reg;
 	struct sd_command	*command;
@@ -174,4 +176,21 @@ extern int at91_mci_read_blocks(unsigned int *data,
 				unsigned int blocks,
 				unsigned int block_len);
 
+#ifdef CONFIG_SDCARD_DMA
+/* Most blocks of 512 bytes read by one DMA transfer */
+#ifdef CONFIG_SDCARD_PDC
+#define MCI_DMA_MAX_BLOCKS	512	/* two PDC buffers of 0x8000 words */
+#else
+#define MCI_DMA_MAX_BLOCKS	2048
+#endif
+
+extern int at91_mci_dma_start(unsigned int *data,
+				unsigned int blocks,
+				unsigned int block_len);
+extern int at91_mci_dma_wait(unsigned int *data,
+				unsigned int blocks,
+				unsigned int block_len);
+extern void at91_mci_dma_stop(void);
+#endif
+
 #endif /* #ifndef __MCI_MEDIA_H__ */
@@ -45,6 +45,20 @@ struct nand_chip {
 	unsigned short	pagesize;
 	unsigned char	oobsize;
 	unsigned char	buswidth;
+	unsigned char	read_cache;	/* ONFI READ CACHE supported */
+	unsigned char	set_features;	/* ONFI SET/GET FEATURES supported */
+	unsigned short	timing_modes;	/* ONFI timing modes supported */
+};
+
+/* Asynchronous interface timings of an ONFI timing mode, in ns */
+struct nand_timings {
+	unsigned short	tRC;	/* RE# cycle time */
+	unsigned short	tRP;	/* RE# pulse width */
+	unsigned short	tREH;	/* RE# high hold time */
+	unsigned short	tREA;	/* RE# access time */
+	unsigned short	tWC;	/* WE# cycle time */
+	unsigned short	tWP;	/* WE# pulse width */
+	unsigned short	tWH;	/* WE# high hold time */
 };
 
 struct nand_info {
@@ -58,6 +72,7 @@ struct nand_info {
 	unsigned int	pages_block;	/* number of pages in block */
 
 	unsigned int	buswidth;	/* data bus width (8/16 bits) */
+	unsigned int	read_cache;	/* READ CACHE SEQUENTIAL supported */
 
 	struct nand_ooblayout	*ecclayout;
 };
@@ -73,6 +88,9 @@ struct nand_info {
 #define CMD_READ_1			0x00
 #define CMD_READ_2			0x30
 
+#define CMD_READ_CACHE			0x31
+#define CMD_READ_CACHE_END		0x3F
+
 #define CMD_READID			0x90
 
 #define CMD_WRITE_1			0x80
@@ -99,4 +117,6 @@ struct nand_info {
 #define CMD_SET_FEATURE			0xEF
 #define CMD_GET_FEATURE			0xEE
 
+#define FEATURE_TIMING_MODE		0x01
+
 #endif /* #ifndef __NAND_H__ */
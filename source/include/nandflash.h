@@ -30,4 +30,20 @@
 
 extern int load_nandflash(struct image_info *image);
 
+/*
+ * NAND bitflip statistics
+ *
+ * nand_stats_fixup_dt() exports them in the /chosen "nand-bitflips"
+ * property, as big-endian 32-bit cells: the ECC strength (bits per
+ * sector) and the ECC sector size, then for each block which had
+ * corrected bits or read retries: the block number, the most bits
+ * corrected in one sector, the bits corrected in the block and the
+ * number of retries.
+ */
+#ifdef CONFIG_NANDFLASH_STATS
+extern int nand_stats_fixup_dt(void *blob);
+#else
+#define nand_stats_fixup_dt(blob)
+#endif
+
 #endif /* #ifndef __NANDFLASH_H__ */
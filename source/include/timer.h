@@ -32,6 +32,8 @@ extern int timer_init(void);
 
 extern void udelay(unsigned int usec);
 
+extern unsigned long long timer_get_ticks(void);
+
 extern int start_interval_timer(void);
 extern int wait_interval_timer(unsigned int usec);
 
@@ -101,7 +101,7 @@ static inline unsigned int of_dt_struct_offset(void *blob, unsigned int offset)
 	return (unsigned int)blob + of_get_offset_dt_struct(blob) + offset;
 }
 
-static inline unsigned int of_get_dt_total_size(void *blob)
+unsigned int of_get_dt_total_size(void *blob)
 {
 	struct boot_param_header *header = (struct boot_param_header *)blob;
 
@@ -583,6 +583,31 @@ int fixup_chosen_node(void *blob, char *bootargs)
 	return 0;
 }
 
+/* Add or update any other property of the /chosen node */
+int fixup_chosen_property(void *blob,
+			char *property_name,
+			void *value,
+			int valuelen)
+{
+	int nodeoffset;
+	int ret;
+
+	ret = of_get_node_offset(blob, "chosen", &nodeoffset);
+	if (ret) {
+		dbg_log(1, "DT: doesn't support add node\n\r");
+		return ret;
+	}
+
+	ret = of_set_property(blob, nodeoffset,
+			property_name, value, valuelen);
+	if (ret) {
+		dbg_log(1, "DT: fail to set %s property\n\r", property_name);
+		return ret;
+	}
+
+	return 0;
+}
+
 /* The /memory node
  * Required properties:
  * - device_type: has to be "memory".
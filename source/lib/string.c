@@ -28,25 +28,120 @@
 #include "string.h"
 #include "common.h"
 
+/*
+ * The bulk of memcpy/memset/memmove is done in 32-byte bursts, eight words
+ * loaded or stored back to back, which the compiler turns into LDM/STM.
+ * The unaligned head and tail are done byte per byte.
+ */
+#define BURST_SIZE	32
+
+static inline int is_word_aligned(const void *p)
+{
+	return ((unsigned int)p & 3) == 0;
+}
+
+/*
+ * Copy forward. When the source is not word aligned against the
+ * destination, aligned source words are shifted and merged into aligned
+ * destination words (little endian only).
+ */
 void *memcpy(void *dst, const void *src, int cnt)
 {
 	char *d = (char *)dst;
 	const char *s = (const char *)src;
+	unsigned int *wd;
+	const unsigned int *ws;
+	unsigned int w0, w1, w2, w3, w4, w5, w6, w7;
+	unsigned int shift;
+
+	if (cnt >= 8) {
+		while (!is_word_aligned(d)) {
+			*d++ = *s++;
+			cnt--;
+		}
 
-	while (cnt--)
+		wd = (unsigned int *)d;
+
+		if (is_word_aligned(s)) {
+			ws = (const unsigned int *)s;
+
+			while (cnt >= BURST_SIZE) {
+				w0 = ws[0]; w1 = ws[1]; w2 = ws[2]; w3 = ws[3];
+				w4 = ws[4]; w5 = ws[5]; w6 = ws[6]; w7 = ws[7];
+				wd[0] = w0; wd[1] = w1; wd[2] = w2; wd[3] = w3;
+				wd[4] = w4; wd[5] = w5; wd[6] = w6; wd[7] = w7;
+				ws += 8;
+				wd += 8;
+				cnt -= BURST_SIZE;
+			}
+
+			while (cnt >= 4) {
+				*wd++ = *ws++;
+				cnt -= 4;
+			}
+
+			s = (const char *)ws;
+		} else {
+			shift = ((unsigned int)s & 3) << 3;
+			ws = (const unsigned int *)(s - ((unsigned int)s & 3));
+
+			w0 = *ws++;
+			while (cnt >= 4) {
+				w1 = *ws++;
+				*wd++ = (w0 >> shift) | (w1 << (32 - shift));
+				w0 = w1;
+				cnt -= 4;
+			}
+
+			s = (const char *)(ws - 1) + (shift >> 3);
+		}
+
+		d = (char *)wd;
+	}
+
+	while (cnt-- > 0)
 		*d++ = *s++;
 
-	return d;
+	return dst;
 }
 
 void *memset(void *dst, int val, int cnt)
 {
 	char *d = (char *)dst;
+	unsigned int *wd;
+	unsigned int w;
 
-	while (cnt--)
+	if (cnt >= 8) {
+		while (!is_word_aligned(d)) {
+			*d++ = (char)val;
+			cnt--;
+		}
+
+		w = val & 0xff;
+		w |= w << 8;
+		w |= w << 16;
+
+		wd = (unsigned int *)d;
+
+		while (cnt >= BURST_SIZE) {
+			wd[0] = w; wd[1] = w; wd[2] = w; wd[3] = w;
+			wd[4] = w; wd[5] = w; wd[6] = w; wd[7] = w;
+			wd += 8;
+			cnt -= BURST_SIZE;
+		}
+
+		while (cnt >= 4) {
+			*wd++ = w;
+			cnt -= 4;
+		}
+
+		d = (char *)wd;
+	}
+
+	while (cnt-- > 0)
 		*d++ = (char)val;
 
-	return d;
+	return dst;
 }
 
 int memcmp(const void *dst, const void *src, unsigned int cnt)
@@ -153,19 +248,46 @@ void *memchr(void *src, int val, unsigned int cnt)
 void *memmove(void *dst, const void *src, unsigned int cnt)
 {
 	char *p, *s;
+	unsigned int *wp, *ws;
+	unsigned int w0, w1, w2, w3, w4, w5, w6, w7;
 
-	if (dst <= src) {
-		p = (char *)dst;
-		s = (char *)src;
-		while (cnt--)
-			*p++ = *s++;
-		}
-	else {
-		p = (char *)dst + cnt;
-		s = (char *)src + cnt;
-		while (cnt--)
+	/* memcpy() copies forward, which is safe unless dst overlaps src end */
+	if ((dst <= src) || ((char *)dst >= ((char *)src + cnt)))
+		return memcpy(dst, src, cnt);
+
+	p = (char *)dst + cnt;
+	s = (char *)src + cnt;
+
+	if ((cnt >= 8) && (((unsigned int)p & 3) == ((unsigned int)s & 3))) {
+		while (!is_word_aligned(p)) {
 			*--p = *--s;
+			cnt--;
+		}
+
+		wp = (unsigned int *)p;
+		ws = (unsigned int *)s;
+
+		while (cnt >= BURST_SIZE) {
+			ws -= 8;
+			wp -= 8;
+			w7 = ws[7]; w6 = ws[6]; w5 = ws[5]; w4 = ws[4];
+			w3 = ws[3]; w2 = ws[2]; w1 = ws[1]; w0 = ws[0];
+			wp[7] = w7; wp[6] = w6; wp[5] = w5; wp[4] = w4;
+			wp[3] = w3; wp[2] = w2; wp[1] = w1; wp[0] = w0;
+			cnt -= BURST_SIZE;
+		}
+
+		while (cnt >= 4) {
+			*--wp = *--ws;
+			cnt -= 4;
 		}
 
+		p = (char *)wp;
+		s = (char *)ws;
+	}
+
+	while (cnt--)
+		*--p = *--s;
+
 	return dst;
 }
@@ -37,6 +37,8 @@
 #include "flash.h"
 #include "string.h"
 #include "onewire_info.h"
+#include "mmu.h"
+#include "bootstage.h"
 
 extern int load_kernel(struct image_info *img_info);
 
@@ -85,6 +87,9 @@ int main(void)
 
 	char filename[FILENAME_BUF_LEN];
 	char of_filename[FILENAME_BUF_LEN];
+#ifdef CONFIG_SDCARD_INITRD
+	char initrd_filename[FILENAME_BUF_LEN];
+#endif
 
 	/* added by MYIR */
 	unsigned int sn, rev;
@@ -121,22 +126,43 @@ int main(void)
 
 #ifdef CONFIG_SDCARD
 	media_str = "SD/MMC: ";
+#ifdef CONFIG_SDCARD_RAW
+	image.offset = IMG_ADDRESS;
+	image.length = IMG_SIZE;
+#ifdef CONFIG_OF_LIBFDT
+	image.of_offset = OF_OFFSET;
+	image.of_length = OF_LENGTH;
+#endif
+#endif
 	image.filename = filename;
 	strcpy(image.filename, OS_IMAGE_NAME);
 #ifdef CONFIG_OF_LIBFDT
 	image.of_filename = of_filename;
 	strcpy(image.of_filename, OF_FILENAME);
 #endif
+#ifdef CONFIG_SDCARD_INITRD
+	image.initrd = 1;
+	image.initrd_dest = (unsigned char *)INITRD_ADDRESS;
+	image.initrd_filename = initrd_filename;
+	memset(initrd_filename, 0, FILENAME_BUF_LEN);
+	strcpy(image.initrd_filename, INITRD_FILENAME);
+#endif
 #endif
 
 #ifdef CONFIG_HW_INIT
 	hw_init();
 #endif
 
+#ifdef CONFIG_MMU
+	bootstage_mark("mmu_enable");
+	mmu_enable();
+#endif
+
 	display_banner();
 
 #ifdef CONFIG_LOAD_ONE_WIRE
 	/* Load one wire informaion */
+	bootstage_mark("load_1wire_info");
 	load_1wire_info();
 #endif
 
@@ -149,6 +175,7 @@ int main(void)
 
 	init_loadfunction();
 
+	bootstage_mark("load_image");
 	ret = (*load_image)(&image);
 
 	if (media_str)
@@ -167,8 +194,16 @@ int main(void)
 	}
 
 #ifdef CONFIG_SCLK
+	bootstage_mark("slowclk_switch");
 	slowclk_switch_osc32();
 #endif
 
+	bootstage_mark("jump");
+	bootstage_report();
+
+#ifdef CONFIG_MMU
+	mmu_disable();
+#endif
+
 	return JUMP_ADDR;
 }
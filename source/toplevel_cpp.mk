@@ -25,6 +25,10 @@ ifeq ($(CONFIG_DEBUG),y)
 CPPFLAGS += -DCONFIG_DEBUG
 endif
 
+ifeq ($(CONFIG_BOOTSTAGE),y)
+CPPFLAGS += -DCONFIG_BOOTSTAGE
+endif
+
 ifeq ($(CONFIG_HW_INIT),y)
 CPPFLAGS += -DCONFIG_HW_INIT
 endif